@@ -0,0 +1,68 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: CrossSection.h
+*
+* Description: Inelastic cross section estimate from sampled impact parameters, with its statistical error
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef CROSSSECTION_H
+#define CROSSSECTION_H
+
+//includes
+#include <iostream>
+
+//CrossSection object, sigma_inel estimated as the mean over samples of (area impact parameters are sampled from) x (fraction of them with a
+//collision); every sample is a fresh pair of nuclei, so the samples are independent and the error is the standard error of their mean
+//the counts of impact parameters tried and hit are kept alongside, and estimates from separate threads or runs are merged by adding them up
+class CrossSection{
+  protected:
+	long n_samp_; long n_trials_; long n_hits_; //samples, and impact parameters tried and with a collision over all samples
+	double sum_; double sum2_; double area_sum_; //sums of the sample estimates, their squares, and the sampled areas
+	
+  public:
+	//empty estimate
+	CrossSection() : n_samp_(0), n_trials_(0), n_hits_(0), sum_(0.), sum2_(0.), area_sum_(0.) {}
+	//reading an estimate back from the binary state written by write_state; a failed read leaves in.fail() set
+	CrossSection(std::istream& in);
+	
+	//adding a sample: impact parameters tried and hit, its estimate of sigma_inel (fm^2), and the area the impact parameters were sampled from
+	void add(long trials, long hits, double sample, double area){++n_samp_; n_trials_ += trials; n_hits_ += hits; sum_ += sample; sum2_ += sample*sample; area_sum_ += area;}
+	//adding the samples of another estimate into this one
+	void merge(const CrossSection& other){
+		n_samp_ += other.n_samp_; n_trials_ += other.n_trials_; n_hits_ += other.n_hits_; sum_ += other.sum_; sum2_ += other.sum2_; area_sum_ += other.area_sum_;
+	}
+	//writing the binary state (of fixed size)
+	void write_state(std::ostream& out) const;
+	//writing the estimate as an output file section, in the layout of the histograms
+	void write(std::ostream& out) const;
+	
+	//sigma_inel and its statistical error in fm^2 (1 fm^2 = 10 mb), and the mean sampled area
+	double sigma() const {return (n_samp_ > 0) ? sum_/n_samp_ : 0.;}
+	double err() const;
+	double mean_area() const {return (n_samp_ > 0) ? area_sum_/n_samp_ : 0.;}
+	
+	//getters
+	long n_samples() const {return n_samp_;} long n_trials() const {return n_trials_;} long n_hits() const {return n_hits_;}
+};
+
+#endif //CROSSSECTION_H
@@ -29,36 +29,200 @@
 #define EVENT_H
 
 //includes
-#include <random>
+#include <vector>
+#include <algorithm>
 #include "Event.h"
 #include "Nucleus.h"
+#include "Random.h"
+#include "Grid.h"
+#include "TaskPool.h"
 
 //event class takes in nuclei settings and collides them; can report event collision statistics
 class Event{
   protected:
 	int num_coll_; int num_part_; double area_tot_; //members for event collision statistics
 	int a_type_; int a_npro_; int a_nneu_; int b_type_; int b_npro_; int b_nneu_; //members for nuclei settings
+	double coll_dist_; //nucleon-nucleon collision distance in fm
+	Nucleus nuc_a_; Nucleus nuc_b_; //nuclei are kept and refilled for every event, rather than reconstructed (and reseeded) each time
+	//the nuclei of the last collision, ones given to collide() or nullptr for this event's own, so a copied or moved event refers to its own copies
+	Nucleus* last_a_; Nucleus* last_b_;
+	void last(Nucleus& nuc_a, Nucleus& nuc_b){last_a_ = (&nuc_a == &nuc_a_) ? nullptr : &nuc_a; last_b_ = (&nuc_b == &nuc_b_) ? nullptr : &nuc_b;}
+	Nucleus& last_a(){return last_a_ ? *last_a_ : nuc_a_;} Nucleus& last_b(){return last_b_ ? *last_b_ : nuc_b_;}
 	
-	std::mt19937_64 eng; //RNG - Mersenne Twist - 64 bit
-	double ran(); //throw a random double between 0 and 1
-	double maxdist(Nucleus nuc_a, Nucleus nuc_b); //find the max distance between nucleons in 2 nuclei
+	//transverse nucleon positions gathered into contiguous arrays for the collision kernel, in the precision the kernel runs in
+	//sx, sy are the inner (heavy) nucleus sorted in x for the sorted kernel, perm gives the nucleon index of each sorted entry
+	//in hotspot mode, hax, hay, hbx, hby are the hotspot offsets from their nucleon (n_hs_ per nucleon, nucleon by nucleon) and ra, rb the reach
+	//of each nucleon (its furthest hotspot plus half the hotspot collision distance)
+	template<class T> struct Coords{std::vector<T> ax; std::vector<T> ay; std::vector<T> bx; std::vector<T> by; std::vector<T> sx; std::vector<T> sy; std::vector<int> perm;
+	  std::vector<T> hax; std::vector<T> hay; std::vector<T> hbx; std::vector<T> hby; std::vector<T> ra; std::vector<T> rb;};
+	Coords<double> pos_d_; Coords<float> pos_f_;
+	Coords<double>& pos(double) {return pos_d_;} Coords<float>& pos(float) {return pos_f_;} //picking the buffers by precision, pos(T())
+	//all buffers are sized once in the constructor, the single nucleon and deuteron sides are then used with compile-time bounds
+	//per-nucleon collision counts, and participant bitmasks (bit i of word i/64 is set if nucleon i collided)
+	std::vector<int> a_hits_; std::vector<int> b_hits_; std::vector<unsigned long long> a_part_; std::vector<unsigned long long> b_part_;
+	std::vector<int> s_hits_; //collision counts of the sorted inner nucleus, for the sorted kernel
+	//binary collision midpoints in x-y, in the frame of nucleus a (nucleus b is centered at the impact parameter offset b_x_, b_y_)
+	std::vector<double> coll_x_; std::vector<double> coll_y_; double b_x_; double b_y_;
+	int trials_; double b_area_; //impact parameters sampled for the last event until one had a collision, and the area they are sampled from
+	//participant center, and if ecc_ is set the participant positions and their eccentricities/participant plane angles (index n = 2..6)
+	double part_cx_; double part_cy_; std::vector<double> part_x_; std::vector<double> part_y_;
+	bool ecc_; double ecc_n_[7]; double psi_n_[7];
+	void (Event::*kernel_)(Nucleus&, Nucleus&); //collision kernel for this pair of nucleus types, precision and strategy, picked once
+	bool single_; //if the collision kernel runs in single precision
+	int obs_; //observables the collision kernel computes besides n_coll (a mask of the OBS_ flags)
+	int strategy_; //pair search of the collision kernel: 0=all pairs, 1=inner nucleus sorted in x
+	
+	//collision probability profile: 0=black disk (collide within coll_dist_), 1=gray disk, 2=Gaussian, with peak probability prof_amp_
+	//r_cut_ is the largest distance with a nonzero probability (the Gaussian is cut where it drops below prof_eps_), prof_k_ the Gaussian slope
+	int profile_; double prof_amp_; double prof_k_; double r_cut_;
+	static constexpr double prof_eps_ = 1.e-7;
+	std::vector<int> prob_hit_; //outcomes of the candidate pairs of one outer nucleon
+	
+	//hotspot mode: number of hotspots per nucleon (0 = off), their collision distance and the Gaussian width of their spread about the nucleon
+	int n_hs_; double hs_dist_; double hs_width_;
+	int num_coll_hs_; int num_part_hs_; //hotspot pairs that collided, and hotspots that took part in a collision
+	std::vector<int> a_hs_hits_; std::vector<int> b_hs_hits_; std::vector<int> cand_; //per-hotspot collision counts, culled nucleon pair list
+	
+	//split collision pass: the outer loop over nucleus a is cut into chunks run on the workers of pool_ (nullptr = not split)
+	//each worker keeps private collision counts of the inner nucleus (and its hotspots), added up after the pass, and private candidate and
+	//draw outcome lists
+	//each chunk keeps its own results and midpoint list, gathered in chunk order so the list is the same as that of the unsplit pass
+	TaskPool* pool_;
+	struct Part{std::vector<int> hits; std::vector<int> hs_hits; std::vector<int> cand; std::vector<int> hit;};
+	struct Chunk{int n_col; int n_col_hs; double area; std::vector<double> mx; std::vector<double> my;};
+	std::vector<Part> parts_; std::vector<Chunk> chunks_;
+	static const int chunk_min_ = 8; //fewest outer nucleons in a chunk
+	static const int chunks_per_worker_ = 4; //chunks per worker, so uneven chunks (most pairs only exist near the overlap) even out
+	
+	Random rng_; //buffered RNG, also hands out the impact parameter azimuths in blocks
+	double ran() {return rng_.uniform();} //throw a random double between 0 and 1
+	unsigned long long draw_key(){return (unsigned long long)(ran()*9007199254740992.);} //random key of a probabilistic pass, 53 bits from one draw
+	template<class T> double maxrad(const T* x, const T* y, int n); //find the max distance of a nucleon from the center of a nucleus in x-y
+	
+	//collision kernel specialised on the coordinate precision T, the nucleus types (0=single nucleon, 1=deuteron, 2=heavy) of nucleus a and b,
+	//and the pair search strategy S (0=all pairs, 1=inner heavy nucleus sorted in x, only used when the inner nucleus is heavy)
+	//the precision only applies to the positions and pair distances, the overlap area is always summed in double
+	//O is the mask of observables computed; the passes and terms for the others are compiled out
+	template<class T, int TA, int TB, int S, int O> void collide_t(Nucleus& nuc_a, Nucleus& nuc_b);
+	//pair loop of the kernel; the outer nucleus has NO nucleons and the inner NI (0 = not fixed, use the runtime count)
+	//the inner loop is a single vectorized scan over the inner nucleus for each outer nucleon; with W set, the inner nucleus is sorted in x
+	//and the scan is cut to the window of inner nucleons within the collision distance in x; midpoints are added to mx, my
+	template<class T, int NO, int NI, bool W, int O> int pairs(const T* xo, const T* yo, int* hitso, int no, const T* xi, const T* yi, int* hitsi, int ni,
+	  T offset_x, T offset_y, T shift_x, T shift_y, double& area, std::vector<double>& mx, std::vector<double>& my);
+	//hotspot collision kernel: nucleon pairs are culled with the nucleon level distance test against the reach of both nucleons, and only the
+	//surviving pairs run the vectorized hotspot-hotspot test; a nucleon pair collides if any pair of their hotspots does
+	template<class T> void collide_hs(Nucleus& nuc_a, Nucleus& nuc_b);
+	//the hotspot pair loop over the nucleons lo to hi-1 of a, with nucleus b offset by (offset_x, offset_y); the collision counts of b and its
+	//hotspots go to hits_b and hs_hits_b, cand is the candidate buffer, and the hotspot pairs that collided are added to n_col_hs
+	template<class T> int pairs_hs(int lo, int hi, double offset_x, double offset_y, int* hits_b, int* hs_hits_b, int* cand,
+	  double& area, int& n_col_hs, std::vector<double>& mx, std::vector<double>& my);
+	//the split pass over no outer nucleons: rows(lo, hi, part, chunk) runs one chunk and returns its N_coll, the private inner counts are
+	//then added to hitsi (ni nucleons) and hs_hitsi (nhi hotspots), and the chunk results to area, n_col_hs and the midpoint list
+	template<class F> int split(int no, int ni, int nhi, F rows, int* hitsi, int* hs_hitsi, double& area, int& n_col_hs);
+	//number of chunks the outer loop over no nucleons is split into (below 2 it is not split)
+	int n_chunks(int no){return (pool_ && (pool_->size() > 1)) ? std::min(chunks_per_worker_*pool_->size(), no/chunk_min_) : 0;}
+	//sampling the hotspot offsets of n nucleons (a 2D Gaussian of width hs_width_ about each) and the reach of each nucleon
+	template<class T> void sample_hs(std::vector<T>& hx, std::vector<T>& hy, std::vector<T>& reach, int n);
+	//pair loop of the probabilistic profiles P (1=gray disk, 2=Gaussian), with the same arguments and results as pairs
+	//for each outer nucleon, the pairs within r_cut_ are compressed into a candidate list in one vectorized pass, and only those get a
+	//probability and a Bernoulli draw, both vectorized over the candidates; the draw is keyed to key and the nucleon indices of the pair, with
+	//the outer nucleons numbered from io0 (the start of a split chunk), so both strategies and the split pass give the same events
+	//cand and hit_c are the candidate and outcome buffers (of at least ni entries), private to a worker in a split pass
+	template<class T, int P, bool W, int O> int pairs_prob(const T* xo, const T* yo, int* hitso, int no, int io0, const T* xi, const T* yi, int* hitsi,
+	  int ni, unsigned long long key, int* cand, int* hit_c, T offset_x, T offset_y, T shift_x, T shift_y, double& area, std::vector<double>& mx,
+	  std::vector<double>& my);
+	//sort the inner nucleus positions in x into the sx, sy buffers of p, with the nucleon index of each entry in perm
+	template<class T> void sort_inner(Coords<T>& p, const T* x, const T* y, int n);
+	//setting the participant bitmask and status flags of a nucleus from its per-nucleon collision counts, returns the number of participants
+	//the participant positions (shifted by shift_x, shift_y) are added to the participant center, and listed if eccentricities are on
+	int mask(Nucleus& nuc, const int* hits, std::vector<unsigned long long>& part, int n, double shift_x, double shift_y);
+	//eccentricities and participant plane angles of orders 2 to 6 from the listed participant positions, in one fused pass
+	void moments();
+	//if nucleus b, offset by (offset_x, offset_y), has any collision with nucleus a in the positions of pos_d_; the scan stops at the first
+	bool any_coll(double offset_x, double offset_y);
+	//picking the kernel for the nucleus types, precision and strategy
+	void (Event::*kernel(bool single_in, int strategy_in))(Nucleus&, Nucleus&);
+	template<int O> void (Event::*kernel_o(bool single_in, int strategy_in))(Nucleus&, Nucleus&);
 	
 	//constants
 	const double pi=3.14159265358979; //const double e=2.71828182845904523;
 	
   public:
+	//observables the collision kernel can compute besides n_coll, which is always counted: the participants (n_part, the per-nucleon
+	//collision counts, participant bitmasks and status flags, and the participant center), the overlap area, and the binary collision midpoints
+	enum {OBS_NPART = 1, OBS_AREA = 2, OBS_MIDPOINTS = 4, OBS_ALL = 7};
+	
 	//need settings for nucleus a and nucleus b
 	//type in denotes type of nucleus 0=single nucleon, 1=deuteron, 2=heavy
 	//n_pro_in is the number of protons in the nucleus, n_neu_in is the same for neutrons
-	Event(int a_type_in, int a_npro_in, int a_nneu_in, int b_type_in, int b_npro_in, int b_nneu_in){
-		a_type_ = a_type_in; a_npro_ = a_npro_in; a_nneu_ = a_nneu_in; b_type_ = b_type_in; b_npro_ = b_npro_in; b_nneu_ = b_nneu_in;
-	}
+	//coll_dist_in is the nucleon-nucleon collision distance in fm
+	Event(int a_type_in, int a_npro_in, int a_nneu_in, int b_type_in, int b_npro_in, int b_nneu_in, double coll_dist_in = 1.);
 	//generate a single event by populating nuclei, colliding them, counting collision statistics
 	void gen();
+	//seed the impact parameter and both nucleus RNGs for a reproducible sequence of events; different streams of one seed are disjoint
+	void seed(unsigned long long seed_in, int stream = 0){rng_.seed(seed_in, stream); nuc_a_.seed(seed_in + 1, stream); nuc_b_.seed(seed_in + 2, stream);}
+	//continue the impact parameter RNG from the state of another one (for a stream prepared elsewhere); the nuclei are left as they are
+	void seed(const Random& from){rng_ = from;}
+	//collide two already filled nuclei (must match the settings this event was given), counting collision statistics
+	//this allows for the same nucleus samples to be shared between events with different collision settings
+	void collide(Nucleus& nuc_a, Nucleus& nuc_b){(this->*kernel_)(nuc_a, nuc_b);}
+	//run the collision kernel (and the positions it uses) in single instead of double precision
+	void single(bool val){single_ = val; kernel_ = kernel(single_, strategy_);} bool single(){return single_;}
+	//pair search strategy of the collision kernel (0=all pairs, 1=inner heavy nucleus sorted in x); the results are the same for both
+	void strategy(int val){strategy_ = val; kernel_ = kernel(single_, strategy_);} int strategy(){return strategy_;}
+	//collision probability profile: 0 = black disk (the default, collide within coll_dist), 1 = gray disk (probability amp within
+	//coll_dist/sqrt(amp)), 2 = Gaussian (probability amp*exp(-amp*b^2/coll_dist^2)); amp in (0,1], every profile has the same
+	//nucleon-nucleon cross section pi*coll_dist^2
+	void profile(int type, double amp);
+	//observables to compute besides n_coll, a mask of the OBS_ flags (default OBS_ALL); the kernel is picked with the others compiled out
+	//n_part and area are zero if left out, and the per-nucleon counts, bitmasks, status flags and midpoints are not updated
+	//eccentricities need the participants, so they are always added with ecc on; the hotspot kernel always computes everything
+	void observables(int val){obs_ = val & OBS_ALL; kernel_ = kernel(single_, strategy_);} int observables(){return obs_;}
+	int profile(){return profile_;} double profile_amp(){return prof_amp_;}
+	//hotspot mode: each nucleon is n_hs hotspots spread as a Gaussian of width width (fm) about its center, colliding within dist (fm)
+	//N_coll, N_part and the participants stay nucleon level (a nucleon pair collides if any of their hotspots do), the area is the summed
+	//hotspot overlap area, and the hotspot level N_coll and N_part are counted as well; n_hs = 0 turns it off
+	void hotspots(int n_hs, double dist, double width);
+	int hotspots(){return n_hs_;} double hs_dist(){return hs_dist_;} double hs_width(){return hs_width_;}
+	//split the collision pass of each event over the workers of a pool (nullptr, the default, runs it on the calling thread alone)
+	//the outer loop over nucleus a is split, so this applies to heavy+heavy collisions (with any profile) and to hotspot mode with a heavy
+	//nucleus a; the results are the same as unsplit (the area up to rounding), and the pool must outlive its use here
+	void pool(TaskPool* val){pool_ = val;} TaskPool* pool(){return pool_;}
+	//if the collision pass is split with the current settings
+	bool splits(){return (n_chunks(a_npro_+a_nneu_) > 1) && ((n_hs_ > 0) || ((a_type_ == 2) && (b_type_ == 2)));}
+	//generate a single event, colliding the same nuclei in both precisions from the same impact parameter random stream
+	//the statistics kept are the ones of this event's precision, the ones of the other precision are returned through the arguments
+	void gen_check(int& n_coll_other, int& n_part_other, double& area_other);
 	//clear stored event
-	void reset(){num_coll_ = 0; num_part_ = 0; area_tot_ = 0.;}
+	void reset(){num_coll_ = 0; num_part_ = 0; area_tot_ = 0.; num_coll_hs_ = 0; num_part_hs_ = 0; b_x_ = 0.; b_y_ = 0.; part_cx_ = 0.; part_cy_ = 0.; trials_ = 0; b_area_ = 0.;}
 	//getters for event statistics
 	int n_coll(){return num_coll_;} int n_part(){return num_part_;} double area(){return area_tot_;}
+	//hotspot level statistics in hotspot mode: colliding hotspot pairs and hotspots taking part in a collision, and the per-hotspot counts
+	int n_coll_hs(){return num_coll_hs_;} int n_part_hs(){return num_part_hs_;} int hs_hits_a(int i){return a_hs_hits_[i];} int hs_hits_b(int i){return b_hs_hits_[i];}
+	//impact parameters sampled for the last event (the first one to have a collision is kept), and the area of the disk they are sampled from
+	//in fm^2; b_area() is a sample of sigma_inel if the first one had a collision and zero otherwise (the later ones are not independent of it)
+	int trials(){return trials_;} double b_area(){return b_area_;}
+	//fast inelastic cross section sampling: fills the nuclei, then tests n_b impact parameters sampled as in the event loop, each only until its
+	//first collision; returns how many had one, with the area they are sampled from in area (area*hits/n_b is then a sample of sigma_inel)
+	//the positions are taken in double precision, and nothing else about the event is set
+	int xsec_trials(int n_b, double& area);
+	//getters for the collision geometry: number of binary collisions of the i'th nucleon of nucleus a or b, if it participated,
+	//the participant bitmasks, the impact parameter offset of nucleus b, and the x-y midpoint of the k'th binary collision (k < n_coll())
+	int hits_a(int i){return a_hits_[i];} int hits_b(int i){return b_hits_[i];}
+	bool part_a(int i){return (a_part_[i >> 6] >> (i & 63)) & 1ULL;} bool part_b(int i){return (b_part_[i >> 6] >> (i & 63)) & 1ULL;}
+	const std::vector<unsigned long long>& part_mask_a(){return a_part_;} const std::vector<unsigned long long>& part_mask_b(){return b_part_;}
+	double b_x(){return b_x_;} double b_y(){return b_y_;}
+	double coll_x(int k){return coll_x_[k];} double coll_y(int k){return coll_y_[k];}
+	//compute the eccentricities and participant plane angles of each event
+	void ecc(bool val){ecc_ = val; kernel_ = kernel(single_, strategy_);} bool ecc(){return ecc_;}
+	//getters for the participant center (frame of nucleus a), and the eccentricity and participant plane angle of order n = 2..6
+	double part_cx(){return part_cx_;} double part_cy(){return part_cy_;}
+	double ecc(int n){return ecc_n_[n];} double psi(int n){return psi_n_[n];}
+	//deposit the sources of the event onto a transverse grid centered between the two nuclei (the grid is not cleared first)
+	//mode 1 deposits each participant nucleon, mode 2 each binary collision midpoint
+	void deposit(Grid& grid, int mode);
+	//getters for the nuclei of the last event made with gen()
+	Nucleus& nuc_a(){return nuc_a_;} Nucleus& nuc_b(){return nuc_b_;}
 };
 
 #endif //EVENT_H
@@ -0,0 +1,93 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Generator.h
+*
+* Description: Embeddable event generator, runs the events of a configuration and hands each one to the caller in-process
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+//includes
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include "Settings.h"
+#include "Event.h"
+#include "Stats.h"
+
+//Generator object, the library entry point: takes a configuration and streams its events, either pulled one at a time with next()
+//or pushed to a callback with run(); nothing is read from or written to files, or printed, unless settings.tunefile names a cache of the
+//autotuned kernel choice (the Settings default has none)
+//seeding, shards, precision validation and adaptive stopping follow the settings exactly as in the Collider executable
+class Generator{
+  protected:
+	Settings settings_; //the configuration
+	Event event_; //the event, refilled for every generated event
+	std::unique_ptr<Stats> stats_; //histograms of all generated events, only kept once bins are given with histogram()
+	std::string tuning_; //description of the collision kernel and hard-core check choice
+	int n_eve_; int i_eve_; //number of events of this run (this shard's share of NumE), and number generated so far
+	bool done_; //set once the run is over (all events made, or the precision target reached)
+	
+	//precision validation: events where the other precision gave a different N_coll or N_part, largest and summed relative area difference
+	int n_diff_coll_; int n_diff_part_; double max_diff_area_; double sum_diff_area_;
+	double target_err_; //largest relative error in the target range at the last precision check (-1 before the first)
+	
+	static const int n_check_ = 100; //events between precision target checks
+	
+  public:
+	//the reason a configuration cannot be generated (bad nuclei, shard or collision profile), or "" if it can
+	//the library never exits: callers check the settings first, Collider.out exits with the message and collider_new returns NULL
+	static std::string check(const Settings& settings);
+	//sets up the event, kernel choice and seeding for the configuration, which must pass check()
+	Generator(const Settings& settings);
+	
+	//keep histograms of every generated event with these bin ends (needed for a precision target, which is not checked without them, so all
+	//NumE events are made), read_bins() gives them from bin files
+	void histogram(std::vector<double> bins_n, std::vector<double> bins_a);
+	
+	//pull interface: generate the next event, returns false (and generates nothing) once the run is over
+	bool next();
+	//push interface: generate the remaining events, calling callback on each; the run stops early if callback returns false
+	//returns the number of events handed to callback
+	int run(const std::function<bool(Event&)>& callback);
+	
+	//the last generated event, with its observables, nuclei and per-nucleon collision counts
+	Event& event(){return event_;}
+	//getters for the configuration and progress; n_eve() drops to the number of events made if the precision target stops the run early
+	const Settings& settings() const {return settings_;} int n_eve() const {return n_eve_;} int i_eve() const {return i_eve_;} bool done() const {return done_;}
+	//histograms of the run, only valid after histogram() was called
+	bool has_stats() const {return (bool)stats_;} Stats& stats(){return *stats_;}
+	//description of the kernel choice, and if it was set, tuned, or cached
+	const std::string& tuning() const {return tuning_;}
+	//precision validation results (only counted with settings.validate)
+	int n_diff_coll() const {return n_diff_coll_;} int n_diff_part() const {return n_diff_part_;}
+	double max_diff_area() const {return max_diff_area_;} double mean_diff_area() const {return (i_eve_ > 0) ? sum_diff_area_/i_eve_ : 0.;}
+	//largest relative error in the target range at the last precision check, and if the target was reached
+	double target_err() const {return target_err_;} bool target_reached() const {return (target_err_ >= 0.) && (target_err_ <= settings_.target);}
+	//recomputes the relative error in the target range now, eg. at the end of a run that used up all NumE events
+	double check_target();
+};
+
+#endif //GENERATOR_H
@@ -0,0 +1,66 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Grid.h
+*
+* Description: Transverse grid of Gaussian-smeared sources (participants or binary collisions), e.g. for hydro initial conditions
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef GRID_H
+#define GRID_H
+
+//includes
+#include <vector>
+#include <ostream>
+
+//Grid object, an n x n transverse (x-y) grid centered at the origin that sources are deposited onto as normalized 2D Gaussians
+//the Gaussian is separable, so each source only needs 1D weights in x and y over its truncated footprint, then a vectorized outer product
+//the buffers are kept between events; clear() then deposit() the sources of each event, and write() it out
+class Grid{
+  protected:
+	int n_; //number of cells on each side
+	double step_; //cell size in fm
+	double sigma_; //Gaussian width in fm
+	int reach_; //half-width of the footprint of a source in cells (the Gaussian is truncated past cut_ widths)
+	std::vector<float> dens_; //density in each cell, row-major in y (cell ix, iy is dens_[iy*n_ + ix])
+	std::vector<float> wx_; std::vector<float> wy_; //1D weights of the current source over its footprint
+	
+	const double pi=3.14159265358979; const double cut_=4.;
+	
+  public:
+	//n_in cells on each side of size step_in fm, sources are Gaussians of width sigma_in fm
+	Grid(int n_in, double step_in, double sigma_in);
+	//zero the grid for a new event
+	void clear();
+	//add a Gaussian source at x_in, y_in (fm), normalized so it integrates to weight
+	void deposit(double x_in, double y_in, double weight = 1.);
+	//write the grid to a binary stream: the grid header, then the n*n float densities (in fm^-2) of each event
+	void write_header(std::ostream& out, int mode); void write(std::ostream& out);
+	
+	//getters
+	int n() {return n_;} double step() {return step_;} double sigma() {return sigma_;}
+	//density in cell ix, iy, and the position of a cell center
+	double operator()(int ix, int iy) {return dens_[iy*n_ + ix];}
+	double center(int i) {return (i - 0.5*(n_ - 1))*step_;}
+};
+
+#endif //GRID_H
@@ -29,6 +29,7 @@
 #define HISTOGRAM_H
 
 #include <cmath>
+#include <iostream>
 
 //there are other available histogram available in various libraries (GSL, boost, ROOT...)
 //demonstrating a 1D histogram template that should handle any object with >= and < operators defined
@@ -65,6 +66,37 @@ class Histogram{
 		for(int ibin=0; ibin<n_bins; ++ibin){hist_[ibin]=0; stddev_[ibin]=T(0.); mean_[ibin]=T(0.); dev_mean_[ibin]=T(0.);}
 	}
 	
+	//copy constructor, also needed since memory is being manually managed (each copy owns its own arrays)
+	Histogram(const Histogram& other){
+		n_bins_ = other.n_bins_;
+		binends_ = new T[n_bins_+1]; hist_ = new int[n_bins_]; stddev_ = new T[n_bins_]; mean_ = new T[n_bins_]; dev_mean_ = new T[n_bins_];
+		for(int ibin=0; ibin<=n_bins_; ++ibin){binends_[ibin]=other.binends_[ibin];}
+		for(int ibin=0; ibin<n_bins_; ++ibin){
+			hist_[ibin]=other.hist_[ibin]; stddev_[ibin]=other.stddev_[ibin]; mean_[ibin]=other.mean_[ibin]; dev_mean_[ibin]=other.dev_mean_[ibin];
+		}
+	}
+	Histogram& operator=(const Histogram& other) = delete;
+	
+	//reading a histogram back from the binary state written by write_state; a failed read leaves in.fail() set
+	Histogram(std::istream& in){
+		n_bins_ = 0; in.read((char*)&n_bins_, sizeof(n_bins_)); if(!in || n_bins_ < 0){n_bins_ = 0; in.setstate(std::ios::failbit);}
+		binends_ = new T[n_bins_+1]; hist_ = new int[n_bins_]; stddev_ = new T[n_bins_]; mean_ = new T[n_bins_]; dev_mean_ = new T[n_bins_];
+		in.read((char*)binends_, sizeof(T)*(n_bins_+1)); in.read((char*)hist_, sizeof(int)*n_bins_);
+		in.read((char*)mean_, sizeof(T)*n_bins_); in.read((char*)stddev_, sizeof(T)*n_bins_);
+		for(int ibin=0; ibin<n_bins_; ++ibin){dev_mean_[ibin]=T(0.);}
+	}
+	//writing the full binary state (bin ends, entries, running means and squared deviations), so no precision is lost between runs
+	void write_state(std::ostream& out) const {
+		out.write((const char*)&n_bins_, sizeof(n_bins_)); out.write((const char*)binends_, sizeof(T)*(n_bins_+1));
+		out.write((const char*)hist_, sizeof(int)*n_bins_); out.write((const char*)mean_, sizeof(T)*n_bins_); out.write((const char*)stddev_, sizeof(T)*n_bins_);
+	}
+	//if another histogram has the same bin ends, so that it can be merged into this one
+	bool same_bins(const Histogram& other) const {
+		if(n_bins_ != other.n_bins_){return false;}
+		for(int ibin=0; ibin<=n_bins_; ++ibin){if(binends_[ibin] != other.binends_[ibin]){return false;}}
+		return true;
+	}
+	
 	//destructor needs to be explicitly declared, since memory is being manually managed
 	//again, using stl vector would alleviate the necessity for this, but is just a demonstration
 	~Histogram(){
@@ -83,6 +115,20 @@ class Histogram{
 		}
 	}
 	
+	//adding the entries of another histogram with the same bin ends into this one
+	//the running means and squared deviations are combined pairwise, so the result matches filling a single histogram with every value
+	void merge(const Histogram& other){
+		for(int ibin=0; ibin<n_bins_; ++ibin){
+			int n_a = hist_[ibin]; int n_b = other.hist_[ibin];
+			if(n_b == 0){continue;}
+			if(n_a == 0){hist_[ibin] = n_b; mean_[ibin] = other.mean_[ibin]; stddev_[ibin] = other.stddev_[ibin]; continue;}
+			T delta = other.mean_[ibin] - mean_[ibin];
+			mean_[ibin] += delta*(double(n_b)/double(n_a + n_b));
+			stddev_[ibin] += other.stddev_[ibin] + delta*delta*(double(n_a)*double(n_b)/double(n_a + n_b));
+			hist_[ibin] = n_a + n_b;
+		}
+	}
+	
 	//CAUTION, there are no bounds checking for any of the below; if this was a proper library then it may be a good idea to add checks
 	//return lower and upper bounds for the i'th bin
 	T bin_low(int i){return binends_[i];} T bin_high(int i){return binends_[i+1];}
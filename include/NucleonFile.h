@@ -0,0 +1,106 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: NucleonFile.h
+*
+* Description: Compact binary per-event nucleon output (fixed-point positions, isospin and participant status), with an asynchronous writer and a memory-mapped reader
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef NUCLEONFILE_H
+#define NUCLEONFILE_H
+
+//includes
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "Event.h"
+
+//file layout (native byte order):
+//  header: tag "GLNUCL01", resolution (double, fm), delta encoding (int), nucleons in a and b (int, int)
+//  events: impact parameter offset b_x, b_y (double), N_coll, N_part (int), then the nucleons of a and of b; each nucleon is its x, y, z
+//          rounded to a multiple of the resolution and stored as zigzag varints (1 to 5 bytes), then one flag byte (bit 0 proton, bit 1 participant)
+//          with delta encoding, the nucleons of each nucleus are stored in order of x, and each x is stored as the step from the one before
+//  index: the byte offset of every event (unsigned long long), then the number of events, the offset of the index, and the tag "GLNUCEND"
+//positions are in the frame of their own nucleus; nucleus b sits at the impact parameter offset
+
+//NucleonWriter object, encodes the nucleons of each event and hands them to a background thread that writes them out
+//the encoding is done right away (it is cheap), the file writes run in the background on swapped buffers so the event loop never waits on the disk
+class NucleonWriter{
+  protected:
+	std::ofstream out_; std::string filename_; //the output file and its name
+	double res_; bool delta_; int n_a_; int n_b_; //resolution, delta encoding, and nucleons per nucleus
+	std::vector<unsigned long long> index_; unsigned long long pos_; //byte offset of each event, and of the next one
+	std::string fill_; std::string flush_; //buffer being filled by the event loop, and the one being written by the writer thread
+	std::thread writer_; std::mutex lock_; std::condition_variable wake_; bool pending_; bool stop_; //writer thread and its handoff
+	bool failed_; //set by the writer thread if a write failed, reported (and the run stopped) at the next handoff or on closing
+	std::vector<long long> qx_; std::vector<long long> qy_; std::vector<long long> qz_; std::vector<int> order_; //quantized nucleus, and its order
+	
+	static const std::size_t buffer_size_ = 1 << 20; //bytes collected before a buffer is handed to the writer thread
+	
+	void put_varint(long long val); //zigzag varint to the fill buffer
+	void put_nucleus(Nucleus& nuc, int n); //quantize and encode the nucleons of a nucleus
+	void hand_over(); //hand the fill buffer to the writer thread, waiting if it is still writing the previous one
+	void check(); //stop the run if a write failed
+	void work(); //writer thread body
+	
+  public:
+	//opens the file and writes the header; resolution in fm, delta encoding on or off, and the nucleons in each nucleus
+	NucleonWriter(const std::string& filename, double res, bool delta, int n_a, int n_b);
+	NucleonWriter(const NucleonWriter& other) = delete; NucleonWriter& operator=(const NucleonWriter& other) = delete;
+	//finishes writing (the index is written last) and closes the file; exits if any write failed
+	~NucleonWriter();
+	
+	//encode the nucleons of the last event
+	void write(Event& event);
+	//number of events written
+	long n_events(){return index_.size();}
+};
+
+//NucleonReader object, maps a nucleon file into memory and decodes any event by its index
+class NucleonReader{
+  protected:
+	const char* map_; std::size_t map_size_; //the mapped file
+	double res_; bool delta_; int n_a_; int n_b_; //header values
+	const char* index_; long n_eve_; //byte offset of each event (unaligned in the map, so read with memcpy), and the number of events
+	
+  public:
+	//a decoded nucleon, and a decoded event
+	struct Nucleon{double x; double y; double z; int id; int stat;};
+	struct Record{double b_x; double b_y; int n_coll; int n_part; std::vector<Nucleon> a; std::vector<Nucleon> b;};
+	
+	//maps the file and checks its header and index (exits if it is missing, not a nucleon file, or was not closed)
+	NucleonReader(const std::string& filename);
+	NucleonReader(const NucleonReader& other) = delete; NucleonReader& operator=(const NucleonReader& other) = delete;
+	~NucleonReader();
+	
+	//decode event i (0 <= i < n_events()) into rec
+	void event(long i, Record& rec) const;
+	
+	//getters
+	long n_events() const {return n_eve_;} double resolution() const {return res_;} bool delta() const {return delta_;}
+	int n_a() const {return n_a_;} int n_b() const {return n_b_;}
+};
+
+#endif //NUCLEONFILE_H
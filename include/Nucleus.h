@@ -29,33 +29,62 @@
 #define NUCLEUS_H
 
 #include <vector>
-#include <random>
+#include <cmath>
 #include "Nucleon.h"
+#include "Random.h"
+#include "PackedNucleon.h"
+
+//compile-time number of nucleons for each nucleus type: 1 for a single nucleon, 2 for a deuteron, 0 (not fixed) for a heavy nucleus
+template<int TYPE> struct NucleusSize{static const int value = 0;};
+template<> struct NucleusSize<0>{static const int value = 1;};
+template<> struct NucleusSize<1>{static const int value = 2;};
 
 //Nucleus object, fills nucleus based on number of protons, neutrons, and type (heavy, deuteron, or single nucleon for demonstration)
 class Nucleus{
   protected:
-	std::vector<Nucleon> nucleons_; //the more straightforward way to deal with a number of nucleons
+	std::vector<PackedNucleon> nucleons_; //compact records, full Nucleon objects are only made on demand by nucleon()
 	int nuc_type_; //flag to denote the type of nucleus: 0=single nucleon, 1=deuteron, 2=heavy
 	int n_pro_, n_neu_; //number of protons and neutrons in the nucleus
 	
-	std::mt19937_64 eng; //RNG - Mersenne Twist - 64 bit
-	double ran(); //throw a random double between 0 and 1
+	Random rng_; //buffered RNG, also hands out isotropic directions in blocks
+	double ran() {return rng_.uniform();} //throw a random double between 0 and 1
 	
 	void single_nuc(); void deuteron();	void heavy(); //function to sample positions of the nucleons
+	void (Nucleus::*sampler_)(); //one of the above, picked once from the nucleus type in the constructor
 	void center(); //put center of mass of nucleus at x=0,y=0,z=0
 	double mindist(double x_in, double y_in, double z_in); //find the distance to the closest nucleon from x_in,y_in,z_in
 	
+	//hard-core check of heavy(): 0=scan over all placed nucleons with mindist, 1=cell grid of placed nucleons, only the 27 cells around a point are checked
+	//the cell grid has cells of the hard-core distance, points outside of it are clamped to the edge cells (which keeps every close pair in adjacent cells)
+	int hardcore_;
+	std::vector<int> cell_head_; std::vector<int> cell_next_; int cell_n_; double cell_lo_; double cell_inv_; //first nucleon of each cell, next in cell
+	int cell(double v) const {int i = int(std::floor((v - cell_lo_)*cell_inv_)); return (i < 0) ? 0 : (i >= cell_n_) ? cell_n_-1 : i;}
+	bool near_cells(double x_in, double y_in, double z_in, double close); //if any placed nucleon is closer than close to x_in,y_in,z_in
+	
 	//constants
 	const double pi=3.14159265358979; const double e=2.71828182845904523;
 	
   public:
+	//Woods-Saxon (heavy nucleus) and Hulthen (deuteron) parameters of the samplers, shared with the optical Glauber thickness functions
+	//heavy nuclei are sampled out to 5 Woods-Saxon radii, deuterons out to deut_rmax
+	static constexpr double ws_a = 0.535; static constexpr double hulthen_a = 0.228; static constexpr double hulthen_b = 1.18; static constexpr double deut_rmax = 3.*7.3;
+	static double ws_radius(int n_nuc){return 1.25*pow(n_nuc, (1./3.));}
+	
 	Nucleus(int type_in, int npro_in, int nneu_in); //constructor; type in denotes type of nucleus, n_pro_in is the number of protons in the nucleus, n_neu_in is the same for neutrons
 	void fill(); //fill the nucleus with nucleons w.r.t. settings
+	void seed(unsigned long long seed_in, int stream = 0) {rng_.seed(seed_in, stream);} //seed the RNG for a reproducible sequence of nuclei
+	void seed(const Random& from) {rng_ = from;} //continue from the state of another RNG (for a stream prepared elsewhere)
+	//hard-core check used when filling a heavy nucleus (0=scan, 1=cell grid); both accept the same nucleons, they only differ in speed
+	void hardcore(int mode) {hardcore_ = mode;} int hardcore() const {return hardcore_;}
+	
+	//number of nucleons in the nucleus, and the nucleus type
+	int size() const {return n_pro_ + n_neu_;} int type() const {return nuc_type_;}
 	
-	//accessing the i'th nucleon
-	Nucleon& operator[](int i) {return nucleons_[i];}
-	const Nucleon& operator[](int i) const {return nucleons_[i];}
+	//accessing the i'th nucleon record
+	PackedNucleon& operator[](int i) {return nucleons_[i];}
+	const PackedNucleon& operator[](int i) const {return nucleons_[i];}
+	//full Nucleon object for the i'th nucleon, for stages that need more than the positions, isospin and status
+	Nucleon nucleon(int i) const {return nucleons_[i].nucleon();}
 };
 
 #endif //NUCLEUS_H
@@ -0,0 +1,89 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Optical.h
+*
+* Description: Optical Glauber model: mean N_coll, N_part and overlap area against impact parameter from tabulated nuclear thickness functions
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef OPTICAL_H
+#define OPTICAL_H
+
+//includes
+#include <string>
+#include <vector>
+#include "Settings.h"
+
+//Optical object, the deterministic companion of the Monte Carlo: the same nucleon densities the nuclei are sampled from (Woods-Saxon, Hulthen)
+//are projected onto the transverse plane into thickness functions, and the same nucleon-nucleon collision profile is folded with them
+//every function here is radial, tabulated on a uniform grid in r, and the folds are quadratures over the grid vectorized over the inner loop
+//nucleons are taken as independent, so the hard-core distance and the recentering of heavy nuclei are left out (the deuteron, where
+//recentering sets the nucleon separation, is folded with itself); N_coll(b) is exact for independent nucleons, N_part(b) and P_inel(b)
+//are exact when one side is a single nucleon and the usual optical approximations otherwise
+class Optical{
+  public:
+	//values at one impact parameter b (fm): the probability of any collision, and the mean N_coll, N_part and overlap area (fm^2) over all
+	//events at that impact parameter (including the ones without a collision)
+	struct Point{double b; double p_inel; double n_coll; double n_part; double area;};
+	
+  protected:
+	//a radial function on a uniform grid from r=0 with step dr, zero past the last point; point marks a single nucleon (a delta function)
+	struct Table{std::vector<double> val; double dr; bool point; double at(double r) const; double r_max() const {return dr*(val.size() - 1);}};
+	
+	int n_a_; int n_b_; //nucleons in each nucleus
+	double coll_dist_; int profile_; double prof_amp_; double prof_k_; double r_cut_; //collision profile, as in Event
+	Table t_a_; Table t_b_; //thickness functions, normalized to one nucleon
+	Table g_a_; Table g_b_; //collision probability of a nucleon at distance r from the center of a or b with one nucleon of it
+	Table t_ab_; Table area_ab_; Table part_ab_; //N_coll(b)/(n_a n_b), area(b)/(n_a n_b) and N_part(b)
+	double b_max_; //largest impact parameter with a collision
+	
+	static const double dr_; //grid step in fm
+	static const int n_phi_ = 64; //azimuthal points of the table folds (trapezoid rule over a full period)
+	
+	Table thickness(int type, int n_nuc); //thickness function of a nucleus, normalized to one
+	template<class F> static Table project(F density, double r_max); //integral along z of a radial density, normalized to one
+	static Table fold(const Table& f, const Table& g); //2D convolution of two radial functions
+	Table fold_profile(const Table& f, bool area); //2D convolution with the collision profile (times the overlap area if area is set)
+	double profile(double dist, bool area) const; //collision probability at a distance (times the overlap area if area is set)
+	double profile_reach(bool area) const; //largest distance the profile (times area) is nonzero at
+	
+  public:
+	//tabulates everything for the nuclei and collision profile of settings (hotspot mode has no optical counterpart and exits)
+	Optical(const Settings& settings);
+	
+	//the values at impact parameter b
+	Point at(double b) const;
+	//the values on a grid of impact parameters from 0 to b_max() with step db
+	std::vector<Point> grid(double db) const;
+	//inelastic cross section in fm^2, the integral of P_inel over the impact parameter plane
+	double sigma_inel() const;
+	//minimum bias values: the mean impact parameter, N_coll, N_part and area of events with a collision (p_inel is then 1), the same
+	//averages as the means of the Monte Carlo histograms
+	Point min_bias() const;
+	//writing the grid and the minimum bias values to outfile, in the layout of the Monte Carlo output
+	void write(const std::string& outfile, double db) const;
+	
+	//getters
+	double b_max() const {return b_max_;}
+};
+
+#endif //OPTICAL_H
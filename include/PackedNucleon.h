@@ -0,0 +1,60 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: PackedNucleon.h
+*
+* Description: Compact nucleon record holding only what event generation needs
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef PACKEDNUCLEON_H
+#define PACKEDNUCLEON_H
+
+#include "Nucleon.h"
+
+//PackedNucleon object, a 24 byte stand-in for Nucleon (which is around 96 bytes) used by Nucleus during event generation
+//the collision stage only needs the positions, the isospin and the participant status; momentum, mass, and time are left out
+//the transverse position is kept in double for the collision kernel, the longitudinal position only enters the sampling so float is enough
+//the getter/setter names match Nucleon, and a full Nucleon can be made on demand for stages that need it
+class PackedNucleon{
+  protected:
+	double x_, y_; float z_; //position
+	short id_; //particle id (2212 proton, 2112 neutron, 0 if not yet set)
+	signed char status_; //status, 1 for a collision participant
+	
+  public:
+	//default constructor, at the origin
+	PackedNucleon() {x_ = 0.; y_ = 0.; z_ = 0.f; id_ = 0; status_ = 0;}
+	//constructor given position
+	PackedNucleon(double x_in, double y_in, double z_in) {x_ = x_in; y_ = y_in; z_ = float(z_in); id_ = 0; status_ = 0;}
+	
+	//getter functions
+	double x() const {return x_;} double y() const {return y_;} double z() const {return z_;} int id() const {return id_;} int stat() const {return status_;}
+	
+	//setter functions
+	void x(double val) {x_ = val;} void y(double val) {y_ = val;} void z(double val) {z_ = float(val);} void id(int val) {id_ = short(val);}
+	void stat(int val) {status_ = (signed char)(val);}
+	
+	//full nucleon with these values, at rest with E=935MeV, M=935MeV
+	Nucleon nucleon() const {return Nucleon(0., x_, y_, z_, 0.935, 0., 0., 0., 0.935, id_, status_);}
+};
+
+#endif //PACKEDNUCLEON_H
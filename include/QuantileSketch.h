@@ -0,0 +1,80 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: QuantileSketch.h
+*
+* Description: Mergeable streaming quantile sketch (KLL) with bounded memory, giving centrality classes and their mean N_coll and N_part
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+
+//includes
+#include <iostream>
+#include <vector>
+
+//QuantileSketch object, a KLL sketch: the values seen are kept in levels, an item on level h standing for 2^h values
+//when the sketch is over its capacity, the lowest full level is sorted and every other item (from a random start) moves up a level,
+//so the memory stays bounded by about 3k items however many values are added, and the rank of any value is off by about 1.7/k of the total
+//each item also carries the N_coll and N_part of its event, so the items in a range of ranks give that range's mean N_coll and N_part
+//sketches are merged level by level, so per-thread (or per-shard) sketches combine into one for the whole run
+class QuantileSketch{
+  protected:
+	struct Item{double key; double n_coll; double n_part;};
+	int k_; //size parameter, the capacity of the top level
+	long long n_; //number of values added
+	unsigned long long coin_; //xorshift state picking the start of each compaction, so a run is reproducible
+	std::vector<std::vector<Item> > levels_; //items by level
+	
+	static const int max_levels_ = 64; //more than enough for 2^63 values
+	
+	int capacity(int h) const; //capacity of level h, k*(2/3)^(levels above it) but at least 2
+	long size() const; //items kept over all levels
+	long capacity() const; //capacity over all levels
+	void compress(); //compacting levels until the sketch is within its capacity
+	
+  public:
+	//a centrality class: its range in percent (0 = the largest values), the smallest and largest value in it, and its mean N_coll and N_part
+	struct Class{double pct_lo; double pct_hi; double key_lo; double key_hi; double n_coll; double n_part;};
+	
+	//empty sketch with size parameter k (at least 8)
+	QuantileSketch(int k = 1000);
+	//reading a sketch back from the binary state written by write_state; a failed read leaves in.fail() set
+	QuantileSketch(std::istream& in);
+	
+	//adding the value key of an event, with its N_coll and N_part
+	void add(double key, double n_coll, double n_part){levels_[0].push_back(Item{key, n_coll, n_part}); ++n_; if(levels_[0].size() >= capacity(0)){compress();}}
+	//adding the values of another sketch (with the same k) into this one
+	void merge(const QuantileSketch& other);
+	//writing the binary state; its size only depends on k, so it can be rewritten in place as the sketch fills
+	void write_state(std::ostream& out) const;
+	
+	//the value with a fraction q of the values below it (0 <= q <= 1)
+	double quantile(double q) const;
+	//n_classes centrality classes of equal size, from the largest values down
+	std::vector<Class> classes(int n_classes) const;
+	
+	//getters
+	int k() const {return k_;} long long n() const {return n_;}
+};
+
+#endif //QUANTILESKETCH_H
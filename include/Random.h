@@ -0,0 +1,77 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Random.h
+*
+* Description: Buffered uniform random numbers from a vectorized generator, with batched direction and azimuth helpers
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef RANDOM_H
+#define RANDOM_H
+
+//includes
+#include <vector>
+
+//Random object, hands out uniform doubles in [0,1) from a buffer that is refilled in blocks
+//the generator is xoshiro256+ run as n_lanes_ independent streams side by side, so a block is filled by a vectorized loop
+//azimuths (cos and sin of a uniform angle) and isotropic unit vectors are also made in vectorized blocks, without calls to libm
+class Random{
+  protected:
+	static const int n_lanes_ = 8; //number of interleaved generator streams
+	static const int n_block_ = 4096; //number of values made per refill
+	
+	unsigned long long s0_[n_lanes_], s1_[n_lanes_], s2_[n_lanes_], s3_[n_lanes_]; //generator state of each stream
+	std::vector<double> uni_; int i_uni_; //uniform buffer and position of the next value
+	std::vector<double> cph_, sph_; int i_az_; //azimuth buffer (cos and sin) and position of the next value
+	std::vector<double> ux_, uy_, uz_; int i_dir_; //isotropic direction buffer and position of the next value
+	
+	void refill(); void refill_az(); void refill_dir(); //fill the uniform, azimuth and direction buffers, sized on first use
+	
+  public:
+	//seeded from std::random_device
+	Random();
+	//seed the generator for a reproducible stream (clears the buffers)
+	//streams with the same seed and a different stream index are disjoint: each index skips 2^128 draws of every generator stream
+	void seed(unsigned long long seed_in, int stream = 0);
+	//skip ahead by 2^128 draws of every generator stream (clears the buffers)
+	void jump();
+	
+	//next uniform double in [0,1)
+	double uniform() {if(i_uni_ == n_block_){refill();} return uni_[i_uni_++];}
+	//next azimuth, as the cos and sin of a uniform angle in [0, 2pi)
+	void azimuth(double& cos_ph, double& sin_ph){if(i_az_ == n_block_){refill_az();} cos_ph = cph_[i_az_]; sin_ph = sph_[i_az_++];}
+	//next isotropic unit vector
+	void direction(double& x, double& y, double& z){
+		if(i_dir_ == n_block_){refill_dir();}
+		x = ux_[i_dir_]; y = uy_[i_dir_]; z = uz_[i_dir_++];
+	}
+	
+	//batched forms: n uniform doubles, n azimuths, n isotropic unit vectors
+	void uniform(double* out, int n);
+	void azimuths(double* cos_ph, double* sin_ph, int n);
+	void directions(double* x, double* y, double* z, int n);
+	
+	//cos and sin of 2*pi*u for n values of u in [0,1), vectorized; accurate to around 1e-15
+	static void sincos2pi(const double* u, double* cos_out, double* sin_out, int n);
+};
+
+#endif //RANDOM_H
@@ -0,0 +1,91 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Scan.h
+*
+* Description: Parameter scan, runs many collision configurations in one process over a shared pool of worker threads
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef SCAN_H
+#define SCAN_H
+
+//includes
+#include <vector>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include "Settings.h"
+#include "Stats.h"
+#include "Event.h"
+#include "TaskPool.h"
+
+//Scan object, reads a scan file where every line is one configuration (given as tag/value pairs on top of the base settings)
+//all configurations are run together: the events are split into blocks handed out to a pool of worker threads, and in every event each
+//distinct nucleus species is sampled once and shared by all configurations using that species
+//for very costly events the blocks are few and large, so the last ones leave threads idle; the events are then instead made one at a time
+//with the collision pass of each split over all threads (see Event::pool), whichever is faster going by the measured cost of an event
+class Scan{
+  protected:
+	//a distinct nucleus species, (type, protons, neutrons)
+	struct Species{int type; int npro; int nneu;};
+	
+	std::vector<Settings> configs_; //one entry per configuration in the scan file
+	std::vector<Species> species_; //every distinct nucleus in the scan
+	std::vector<int> spec_a_; std::vector<int> spec_b_; //species index of nucleus a and nucleus b for each configuration
+	std::vector<Stats> stats_; //merged statistics for each configuration
+	std::vector<int> strategy_; std::vector<int> hardcore_; //collision kernel strategy of each configuration, hard-core check of each species
+	int n_eve_max_; //largest number of events over all configurations
+	unsigned long long seed_; //RNG seed of the scan (0 = seed from std::random_device), the same for every configuration
+	int n_blocks_; //number of event blocks handed out to the workers
+	
+	std::atomic<int> next_block_; int done_blocks_; //block bookkeeping shared by the workers
+	std::mutex merge_lock_; //guards progress output
+	
+	//two level merging: every worker merges into the statistics of its NUMA node, and the nodes are merged into stats_ at the end
+	//a node's statistics are taken over from the first worker to finish on that node, so (when pinned) they live in that node's memory
+	std::vector<std::vector<Stats> > node_stats_; std::unique_ptr<std::mutex[]> node_lock_;
+	
+	static const int block_size_ = 100; //events per block handed to a worker
+	static const int n_rounds_ = 3; static const int n_coll_ = 5; //rounds of measuring an event, and collisions timed per round
+	
+	int species(int type_in, int npro_in, int nneu_in); //find (or add) the species index for a nucleus
+	void add_event(std::vector<Event>& events, int icon); //add an event holding the collision settings of a configuration, built in place
+	//measured time of one event of the scan (every species filled and every configuration collided, weighted by its share of the events),
+	//with the collision passes run unsplit (t_events) and split over pool (t_split)
+	void measure(TaskPool& pool, double& t_events, double& t_split);
+	//worker thread body, pins itself to cpu (if >= 0) and generates blocks of events until none are left, splitting them over pool if given
+	//in a seeded scan every block of events has its own streams, so the events do not depend on the threads or on which one makes a block
+	void work(int cpu, int node, TaskPool* pool);
+	
+  public:
+	//reads the scan file named in base.scanfile; base holds the values used for any tag not given on a line
+	Scan(const Settings& base);
+	//run all configurations with n_threads worker threads (0 = all hardware threads) and write one output file per configuration
+	//pin places the threads on the NUMA nodes: 0 = not pinned, 1 = compact, 2 = scatter (see Topology::place)
+	//parallel runs the events on separate threads (0), or one at a time split over all threads (1), or picks the faster one (-1)
+	void run(int n_threads, int pin = 0, int parallel = -1);
+	//number of configurations read from the scan file
+	int n_configs(){return configs_.size();}
+};
+
+#endif //SCAN_H
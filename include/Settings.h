@@ -0,0 +1,85 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Settings.h
+*
+* Description: Run parameters with their defaults, read from command line switches, a settings file, or a line of a scan file
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <string>
+#include <vector>
+#include <set>
+
+//Settings object, holds every run parameter along with its default value
+//values are set by tag name (the same tags used on the command line and in the settings file), so every input path shares one parser
+//the members are left public on purpose, this is just a bundle of values handed to the event loop
+class Settings{
+  public:
+	int n_eve; //number of events to generate
+	int nuctypea, nuctypeb; //type of nucleus: 0=single nucleon, 1=deuteron, 2=heavy
+	int num_pro_a, num_pro_b, num_neu_a, num_neu_b; //number of protons and neutrons in each nucleus
+	double coll_dist; //nucleon-nucleon collision distance in fm
+	int n_threads; //number of worker threads used in scan mode (0 = use all available hardware threads)
+	int pin; //pinning of the scan worker threads: 0=none, 1=compact (fill one NUMA node first), 2=scatter (alternate between the nodes)
+	int parallel; //scan parallelism: 0=events on separate threads, 1=each event split over all threads, -1 = picked by measuring both
+	bool single_prec; //if positions and the collision kernel are in single (float) precision instead of double
+	bool validate; //if every event is also collided in the other precision, comparing the observables
+	bool ecc; //if the eccentricities and participant plane angles are computed (and histogrammed) for every event
+	int cent_obs, cent_classes, cent_k; //centrality classes: observable (0=n_coll, 1=n_part, 2=area, -1 = none), classes, and sketch size
+	bool optical; double opt_step; //optical Glauber mode instead of Monte Carlo events, and the impact parameter step of its output in fm
+	int xsec; //fast sigma_inel mode: impact parameters tested per pair of nuclei instead of generating events (0 = off)
+	int observables; //observables the run needs besides n_coll, a mask of Event::OBS_NPART, OBS_AREA and OBS_MIDPOINTS
+	int grid_mode; //transverse grid output: 0=none, 1=participants, 2=binary collisions deposited as Gaussians
+	int grid_n; double grid_step; double grid_width; //grid cells per side, cell size in fm, and Gaussian width in fm
+	unsigned long long seed; //RNG seed for reproducible runs (0 = seed from std::random_device)
+	int shard_i, shard_n; //this run makes shard shard_i of shard_n disjoint shares of the events
+	double target; //adaptive stopping: relative error to reach in every bin of the target range (0 = off, always make n_eve events)
+	int target_obs; bool target_mean; int target_lo, target_hi; //target histogram (0=n_coll, 1=n_part, 2=area), mean or entries, bin range
+	int coll_kernel, hardcore; //collision kernel strategy (0=all pairs, 1=sorted) and heavy nucleus hard-core check (0=scan, 1=cells); -1 = autotune
+	int status_every; //events between updates of the live status file
+	int profile; double prof_amp; //collision probability profile (0=black disk, 1=gray disk, 2=Gaussian) and its peak probability
+	int hotspots; double hs_dist, hs_width; //hotspots per nucleon (0 = nucleon level collisions), their collision distance and spread in fm
+	double nuc_res; bool nuc_delta; //nucleon file position resolution in fm, and delta encoding of the positions
+	std::string binfile_n, binfile_a, settingfile, outfile, scanfile, gridfile, statefile, tunefile, statusfile, nucfile; //input/output filenames
+	
+	//default constructor, holds all of the default values
+	Settings();
+	
+	//set a parameter from its tag and a string value; returns false if the tag is not recognized
+	bool set(const std::string& tag, const std::string& val);
+	//read a settings file, skipping any tag in 'locked' (those set on the command line have precedence)
+	void read(const std::string& filename, const std::set<std::string>& locked);
+	//observables the collision kernel has to compute: the ones asked for, and the ones the eccentricities, the grid, the precision target,
+	//and the nucleon file need (the participants, the collision midpoints, the target histogram, and the participant status)
+	int needed_observables() const;
+	//the reason these settings cannot run in scan mode (the message the run exits with), or "" if they can
+	std::string scan_conflict() const;
+	//read a list of bin ends from a bin file
+	static std::vector<double> read_bins(const std::string& filename);
+	//insert tagname before the extension of filename (or append it if there is none), eg. output/output.dat -> output/output_scan1.dat
+	static std::string tag_file(const std::string& filename, const std::string& tagname);
+};
+
+#endif //SETTINGS_H
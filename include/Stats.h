@@ -0,0 +1,110 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Stats.h
+*
+* Description: Collection of the event statistic histograms for a single run configuration
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef STATS_H
+#define STATS_H
+
+//includes
+#include <string>
+#include <vector>
+#include "Histogram.h"
+#include "QuantileSketch.h"
+#include "CrossSection.h"
+#include "Event.h"
+
+//Stats object, bundles the histograms filled once per event so they can be filled, merged between threads, and written out together
+class Stats{
+  protected:
+	//Using double histograms for the double ones because I want double binends to make the bin centers fall exactly on integer values
+	Histogram<double> h_n_coll_; Histogram<double> h_n_part_; Histogram<double> h_area_;
+	std::vector<Histogram<double> > h_ecc_; //eccentricities of order 2 to 6 (index n-2), only if the events compute them
+	std::vector<Histogram<double> > h_hs_; //hotspot level n_coll and n_part (index 0 and 1), only in hotspot mode
+	std::vector<QuantileSketch> cent_; //sketch of the centrality observable (with the N_coll and N_part of each event), only if classes are asked for
+	int cent_obs_; int cent_classes_; //centrality observable (0=n_coll, 1=n_part, 2=area, -1 = none) and number of centrality classes
+	//sigma_inel from the impact parameters the event loop samples: each event is a sample, its sampled area if the first impact parameter
+	//had a collision and zero otherwise (the ones after a miss are only tried because of it, so only the first is an unbiased trial)
+	CrossSection xsec_;
+	long n_eve_; //number of events filled
+	int obs_; //observables the events compute (Event::OBS_ flags), the n_part and area histograms of ones they do not are left empty
+	
+	static const int n_bins_ecc_ = 50; //eccentricity histograms have uniform bins from 0 to 1
+	
+	Stats(std::istream& in); //reading the histograms of a binary state, after its header
+	
+  public:
+	//bins_n are the bin ends for n_coll and n_part, bins_a are the bin ends for the overlap area
+	//if ecc is set, the eccentricities of the events are also histogrammed
+	//with hotspots > 0, so are the hotspot level n_coll and n_part, binned with the bins_n bin ends multiplied by hotspots
+	//observables are the ones the events compute; the n_part and area histograms are only filled if they are in it
+	Stats(std::vector<double>& bins_n, std::vector<double>& bins_a, bool ecc = false, int hotspots = 0, int observables = Event::OBS_ALL);
+	
+	//filling histograms with statistical info. from a generated event
+	void fill(Event& event){
+		h_n_coll_.fill(event.n_coll()); ++n_eve_;
+		if(obs_ & Event::OBS_NPART){h_n_part_.fill(event.n_part());} if(obs_ & Event::OBS_AREA){h_area_.fill(event.area());}
+		for(int iecc=0; iecc<h_ecc_.size(); ++iecc){h_ecc_[iecc].fill(event.ecc(iecc+2));}
+		if(!h_hs_.empty()){h_hs_[0].fill(event.n_coll_hs()); h_hs_[1].fill(event.n_part_hs());}
+		if(!cent_.empty()){cent_[0].add((cent_obs_ == 0) ? event.n_coll() : (cent_obs_ == 1) ? event.n_part() : event.area(), event.n_coll(), event.n_part());}
+		xsec_.add(event.trials(), 1, (event.trials() == 1) ? event.b_area() : 0., event.b_area());
+	}
+	//adding the entries of another Stats object (with the same binning) into this one
+	void merge(const Stats& other){
+		h_n_coll_.merge(other.h_n_coll_); h_n_part_.merge(other.h_n_part_); h_area_.merge(other.h_area_); n_eve_ += other.n_eve_;
+		for(int iecc=0; iecc<h_ecc_.size(); ++iecc){h_ecc_[iecc].merge(other.h_ecc_[iecc]);}
+		for(int ihs=0; ihs<h_hs_.size(); ++ihs){h_hs_[ihs].merge(other.h_hs_[ihs]);}
+		if(!cent_.empty()){cent_[0].merge(other.cent_[0]);}
+		xsec_.merge(other.xsec_);
+	}
+	//also determine n_classes centrality classes of observable obs (0=n_coll, 1=n_part, 2=area), from a quantile sketch with size parameter k
+	//the class boundaries and the mean N_coll and N_part of each class are written after the histograms
+	void centrality(int obs, int n_classes, int k);
+	//writing the histograms to the output file
+	void write(const std::string& outfile);
+	//writing the full binary state of the histograms to statefile, and reading one back (exits if the file is missing or not a state file)
+	//merging the states of separate runs and then writing gives the same output as a single run over all of their events
+	void write_state(const std::string& statefile) const;
+	static Stats read_state(const std::string& statefile);
+	//the same binary state written to and read from a stream (name is the file or source reported if reading fails)
+	void write_state(std::ostream& out) const;
+	static Stats read_state(std::istream& in, const std::string& name);
+	//if another Stats object has the same histograms and binning, so that it can be merged into this one
+	bool same_bins(const Stats& other) const;
+	//largest relative error over the bins lo to hi (inclusive, hi < 0 counts back from the last bin) of histogram obs (0=n_coll, 1=n_part, 2=area)
+	//of the bin means (errmean_bin/mean_bin) if mean is set, otherwise of the entries (errval_bin/val_bin); empty bins have no estimate yet and are skipped
+	//returns a negative value while every bin in the range is empty
+	double rel_err(int obs, bool mean, int lo, int hi);
+	
+	//getters
+	Histogram<double>& n_coll(){return h_n_coll_;} Histogram<double>& n_part(){return h_n_part_;} Histogram<double>& area(){return h_area_;}
+	Histogram<double>& ecc(int n){return h_ecc_[n-2];} bool has_ecc(){return !h_ecc_.empty();}
+	Histogram<double>& n_coll_hs(){return h_hs_[0];} Histogram<double>& n_part_hs(){return h_hs_[1];} bool has_hs(){return !h_hs_.empty();}
+	CrossSection& xsec(){return xsec_;}
+	QuantileSketch& cent(){return cent_[0];} bool has_cent(){return !cent_.empty();} int cent_obs(){return cent_obs_;} int cent_classes(){return cent_classes_;}
+	long n_eve(){return n_eve_;}
+};
+
+#endif //STATS_H
@@ -0,0 +1,72 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: StatusFile.h
+*
+* Description: Live run status in a memory-mapped file: event counters, throughput and the histogram state, readable at any time
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef STATUSFILE_H
+#define STATUSFILE_H
+
+//includes
+#include <string>
+#include <atomic>
+#include <cstddef>
+#include "Stats.h"
+
+//StatusFile object, keeps a snapshot of a running generator in a fixed-layout file mapped into memory, so other processes can follow it live
+//the file is a header (tag, sequence number, counters and timing) followed by the binary histogram state as written by Stats::write_state
+//updates are guarded by a sequence lock: the writer makes the sequence number odd, rewrites the snapshot in place and makes it even again,
+//and a reader retries its copy if the number was odd or changed meanwhile (for a bounded time); the writer never waits for readers
+class StatusFile{
+  protected:
+	//fixed layout at the start of the file; only plain fixed-size members and an address-free atomic, so it can be shared between processes
+	struct Header{
+		char tag[8]; //file tag and format version
+		std::atomic<unsigned long long> seq; //sequence number, odd while an update is in progress
+		long long n_done; long long n_total; //events generated so far, and planned
+		double elapsed; double rate; //wall time in seconds since the start of the run, and events per second
+		long long finished; //nonzero once the run is over and this is the final snapshot
+		long long size; //bytes of histogram state following the header
+	};
+	
+	Header* header_; char* state_; std::size_t map_size_; //the mapped file, and the state right after the header
+	static constexpr double read_timeout_ = 1.; //seconds a reader keeps retrying before it reports the snapshot unavailable
+	
+  public:
+	//creates (or overwrites) the status file, sized for the histograms of stats, and writes a first snapshot
+	StatusFile(const std::string& filename, const Stats& stats, long n_total);
+	StatusFile(const StatusFile& other) = delete; StatusFile& operator=(const StatusFile& other) = delete;
+	~StatusFile();
+	
+	//rewrite the snapshot with the current histograms and counters
+	void update(const Stats& stats, long n_done, long n_total, double elapsed, bool finished = false);
+	
+	//a consistent copy of the snapshot, as read by another process
+	struct Snapshot{long long n_done; long long n_total; double elapsed; double rate; bool finished; std::string state;};
+	//read the snapshot of a status file; returns false (with a message) if the file is missing or not a status file, or if no consistent
+	//copy could be made in time because an update never finished
+	static bool read(const std::string& filename, Snapshot& snap);
+};
+
+#endif //STATUSFILE_H
@@ -0,0 +1,68 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: TaskPool.h
+*
+* Description: Fork-join pool of worker threads, for splitting the work of a single event
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef TASKPOOL_H
+#define TASKPOOL_H
+
+//includes
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+//TaskPool object, a fixed set of worker threads that run the tasks of one job at a time, with the calling thread taking part as worker 0
+//a job is short (one collision pass), so idle workers spin for a little while before they block, and a job is handed out with one counter
+//bump; the tasks of a job are taken in order from a shared counter, each task by exactly one worker, and run() returns when all are done
+class TaskPool{
+  protected:
+	std::vector<std::thread> threads_; //workers 1 to size()-1
+	std::mutex lock_; std::condition_variable wake_; //blocking handoff, for workers that stopped spinning
+	std::atomic<unsigned long long> job_; //bumped for every job (and once more to stop)
+	std::atomic<int> next_; std::atomic<int> busy_; //next task to take, and workers still on the current job
+	const std::function<void(int, int)>* fn_; int n_tasks_; bool stop_; //the current job
+	
+	static const int n_spin_ = 1 << 14; //polls of an idle worker before it blocks
+	
+	void take(int worker); //run tasks of the current job until none are left
+	void work(int worker, int cpu); //worker thread body, pins itself to cpu (if >= 0)
+	
+  public:
+	//a pool of n_threads workers including the caller (so n_threads-1 threads are started); cpu gives the CPU to pin each worker to
+	//(-1, or a missing entry, leaves it unpinned; entry 0 is the caller and is not touched)
+	TaskPool(int n_threads, const std::vector<int>& cpu = std::vector<int>());
+	TaskPool(const TaskPool& other) = delete; TaskPool& operator=(const TaskPool& other) = delete;
+	~TaskPool();
+	
+	//run fn(task, worker) for every task in [0, n_tasks) on the workers, returning once all are done; only one job runs at a time
+	void run(int n_tasks, const std::function<void(int, int)>& fn);
+	//number of workers, including the caller
+	int size() const {return threads_.size() + 1;}
+};
+
+#endif //TASKPOOL_H
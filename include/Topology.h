@@ -0,0 +1,54 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Topology.h
+*
+* Description: NUMA nodes (sockets) of the machine and their CPUs, for placing and pinning worker threads
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+//includes
+#include <vector>
+#include <string>
+
+//Topology object, the NUMA nodes of the machine and the CPUs of each that this process may run on
+//read from /sys/devices/system/node (no libnuma needed); without it, all CPUs are taken to be on a single node
+class Topology{
+  protected:
+	std::vector<std::vector<int> > cpus_; //allowed CPUs of each node, nodes without any are left out
+	
+	static std::vector<int> parse_list(const std::string& list); //parse a kernel cpu list, eg. "0-3,8-11"
+	
+  public:
+	Topology();
+	
+	//number of nodes, and the CPUs of a node
+	int n_nodes() const {return cpus_.size();} const std::vector<int>& cpus(int node) const {return cpus_[node];}
+	//CPU and node for worker ithr: mode 1 (compact) fills node 0 before node 1 etc., mode 2 (scatter) alternates between the nodes
+	void place(int ithr, int mode, int& cpu, int& node) const;
+	//pin the calling thread to a CPU, returns false if that is not possible
+	static bool pin(int cpu);
+};
+
+#endif //TOPOLOGY_H
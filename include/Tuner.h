@@ -0,0 +1,72 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Tuner.h
+*
+* Description: Picks the fastest collision kernel and hard-core check for a configuration, by benchmarking or from a cache file
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef TUNER_H
+#define TUNER_H
+
+//includes
+#include <string>
+#include "Settings.h"
+#include "Event.h"
+#include "Nucleus.h"
+
+//Tuner object, picks the collision kernel strategy (all pairs or sorted) and the hard-core check of each heavy nucleus (scan or cells)
+//anything set in the settings is used as given; the rest is read from the tune file if this system and CPU model are listed there, or
+//otherwise benchmarked on a few warm-up events (with separate nuclei and events, so the random streams of the run are untouched) and cached
+//every choice gives the same results, only the speed differs
+class Tuner{
+  protected:
+	int strategy_; int hardcore_a_; int hardcore_b_; //chosen collision kernel strategy and hard-core checks
+	bool hotspots_; //hotspot mode has its own kernel, so only the hard-core checks are picked
+	std::string source_; //where the choice came from: "set", "cached", or "benchmarked"
+	std::string system_; std::string cpu_; //keys of the tune file entry
+	
+	static const int n_warm_ = 5; //warm-up events (nucleus fills, or sets of nuclei to collide) per benchmark round
+	static const int n_rounds_ = 5; //benchmark rounds, each option is timed once per round and its fastest round is kept
+	static constexpr double margin_ = 0.05; //the second option (sorted, cells) is only picked if it is this much faster, so timing noise keeps the first
+	static const int n_coll_ = 20; //collisions timed per set of nuclei
+	
+	static std::string cpu_model(); //CPU model name from /proc/cpuinfo
+	bool read(const std::string& tunefile); //read the entry for this system and CPU, returns false if there is none
+	void write(const std::string& tunefile); //replace (or add) the entry for this system and CPU
+	static int bench_fill(int type, int npro, int nneu); //fastest hard-core check for a nucleus
+	static int bench_collide(const Settings& settings); //fastest collision kernel strategy for a configuration
+	
+  public:
+	//picks the strategy and hard-core checks for the configuration in settings
+	Tuner(const Settings& settings);
+	//setting the choice on an event and its own nuclei
+	void apply(Event& event){event.strategy(strategy_); event.nuc_a().hardcore(hardcore_a_); event.nuc_b().hardcore(hardcore_b_);}
+	
+	//getters
+	int strategy(){return strategy_;} int hardcore_a(){return hardcore_a_;} int hardcore_b(){return hardcore_b_;}
+	const std::string& source(){return source_;}
+	//one line description of the choice
+	std::string describe();
+};
+
+#endif //TUNER_H
@@ -28,6 +28,8 @@
 #ifndef VEC4_H
 #define VEC4_H
 
+#include <cmath>
+
 //this is a template for a 4-vector
 //for a physical 4-vector, could have just stuck with doubles.
 template <class T>
@@ -44,9 +46,9 @@ class Vec4{
 	Vec4(T tin, T xin, T yin, T zin) {val_[0] = tin; val_[1] = xin; val_[2] = yin; val_[3] = zin;}
 	
 	//getter functions
-	T  x() {return val_[1];} T  y() {return val_[2];} T  z() {return val_[3];} T t() {return val_[0];}
-	T px() {return val_[1];} T py() {return val_[2];} T pz() {return val_[3];} T e() {return val_[0];}
-	T bx() {return val_[1];} T by() {return val_[2];} T bz() {return val_[3];} T g() {return val_[0];}
+	T  x() const {return val_[1];} T  y() const {return val_[2];} T  z() const {return val_[3];} T t() const {return val_[0];}
+	T px() const {return val_[1];} T py() const {return val_[2];} T pz() const {return val_[3];} T e() const {return val_[0];}
+	T bx() const {return val_[1];} T by() const {return val_[2];} T bz() const {return val_[3];} T g() const {return val_[0];}
 	
 	//setter functions
 	void  x(T val) {val_[1] = val;} void  y(T val) {val_[2] = val;} void  z(T val) {val_[3] = val;} void t(T val) {val_[0] = val;}
@@ -54,44 +56,95 @@ class Vec4{
 	void bx(T val) {val_[1] = val;} void by(T val) {val_[2] = val;} void bz(T val) {val_[3] = val;} void g(T val) {val_[0] = val;}
 	
 	//Lorentz boost functions
-	Vec4<T> boost(Vec4 B){
-		Vec4<T> Pout;
-		T xlam[4][4], beta2;
-		beta2 = B.bx()*B.bx() + B.by()*B.by() + B.bz()*B.bz();
-		
+	//B holds the boost as (gamma, beta_x, beta_y, beta_z); for boosting many vectors, build a LorentzBoost once and apply that instead
+	Vec4<T> boost(const Vec4& B) const;
+	Vec4<T> boost(T vx, T vy, T vz) const;
+	
+	//diff^2 function
+	T dif2(const Vec4& comp) const {return (val_[1]-comp.x())*(val_[1]-comp.x()) + (val_[2]-comp.y())*(val_[2]-comp.y()) + (val_[3]-comp.z())*(val_[3]-comp.z());}
+};
+
+//Lorentz boost with its 4x4 matrix computed once, to be applied to any number of 4-vectors
+//the batched apply() functions run over contiguous arrays as a vectorized loop over separate t/x/y/z arrays; an array of Vec4s is gathered
+//into such arrays a block at a time
+template <class T>
+class LorentzBoost{
+	
+  protected:
+	T xlam_[4][4]; //boost matrix
+	
+	//building the boost matrix from gamma and the velocity
+	void build(T g, T bx, T by, T bz){
+		T beta2 = bx*bx + by*by + bz*bz;
 		T beta2inv;
 		if(beta2 > 0.){beta2inv = 1./beta2;}
 		else{beta2inv = 0.;}
 		
-		xlam[0][0] = B.g();
-		xlam[0][1] = -B.g()*B.bx();
-		xlam[0][2] = -B.g()* B.by();
-		xlam[0][3] = -B.g()*B.bz();
-		xlam[1][0] = xlam[0][1];
-		xlam[1][1] = 1.+(B.g() - 1.)*(B.bx()*B.bx())*beta2inv;
-		xlam[1][2] = (B.g()-1.)*B.bx()*B.by()*beta2inv;
-		xlam[1][3] = (B.g()-1.)*B.bx()*B.bz()*beta2inv;
-		xlam[2][0] = xlam[0][2];
-		xlam[2][1] = xlam[1][2];
-		xlam[2][2] = 1.+(B.g()-1.)*(B.by()*B.by())*beta2inv;
-		xlam[2][3] = (B.g()-1.)*B.by()*B.bz()*beta2inv;
-		xlam[3][0] = xlam[0][3];
-		xlam[3][1] = xlam[1][3];
-		xlam[3][2] = xlam[2][3];
-		xlam[3][3] = 1.+(B.g()-1.)*(B.bz()*B.bz())*beta2inv;
-		
-		Pout.e ( val_[0]*xlam[0][0] + val_[1]*xlam[0][1] + val_[2]*xlam[0][2] + val_[3]*xlam[0][3] );
-		Pout.px( val_[0]*xlam[1][0] + val_[1]*xlam[1][1] + val_[2]*xlam[1][2] + val_[3]*xlam[1][3] );
-		Pout.py( val_[0]*xlam[2][0] + val_[1]*xlam[2][1] + val_[2]*xlam[2][2] + val_[3]*xlam[2][3] );
-		Pout.pz( val_[0]*xlam[3][0] + val_[1]*xlam[3][1] + val_[2]*xlam[3][2] + val_[3]*xlam[3][3] );
-		
-		return Pout;
+		xlam_[0][0] = g;
+		xlam_[0][1] = -g*bx;
+		xlam_[0][2] = -g*by;
+		xlam_[0][3] = -g*bz;
+		xlam_[1][0] = xlam_[0][1];
+		xlam_[1][1] = 1.+(g - 1.)*(bx*bx)*beta2inv;
+		xlam_[1][2] = (g-1.)*bx*by*beta2inv;
+		xlam_[1][3] = (g-1.)*bx*bz*beta2inv;
+		xlam_[2][0] = xlam_[0][2];
+		xlam_[2][1] = xlam_[1][2];
+		xlam_[2][2] = 1.+(g-1.)*(by*by)*beta2inv;
+		xlam_[2][3] = (g-1.)*by*bz*beta2inv;
+		xlam_[3][0] = xlam_[0][3];
+		xlam_[3][1] = xlam_[1][3];
+		xlam_[3][2] = xlam_[2][3];
+		xlam_[3][3] = 1.+(g-1.)*(bz*bz)*beta2inv;
 	}
 	
-	Vec4<T> boost(T vx, T vy, T vz){Vec4<T> vin(vx, vy, vz, 1./(sqrt(1. - (vx*vx + vy*vy + vz*vz)))); return this->boost(vin);}
+  public:
+	//boost given as a Vec4 holding (gamma, beta_x, beta_y, beta_z), same as Vec4::boost
+	LorentzBoost(const Vec4<T>& B) {build(B.g(), B.bx(), B.by(), B.bz());}
+	//boost given by the velocity
+	LorentzBoost(T vx, T vy, T vz) {build(1./(std::sqrt(1. - (vx*vx + vy*vy + vz*vz))), vx, vy, vz);}
 	
-	//diff^2 function
-	T dif2(Vec4 comp){return (val_[1]-comp.x())*(val_[1]-comp.x()) + (val_[2]-comp.y())*(val_[2]-comp.y()) + (val_[3]-comp.z())*(val_[3]-comp.z());}
+	//element of the boost matrix
+	T operator()(int i, int j) const {return xlam_[i][j];}
+	
+	//boosting a single 4-vector
+	Vec4<T> apply(const Vec4<T>& P) const {
+		return Vec4<T>(P.t()*xlam_[0][0] + P.x()*xlam_[0][1] + P.y()*xlam_[0][2] + P.z()*xlam_[0][3],
+		               P.t()*xlam_[1][0] + P.x()*xlam_[1][1] + P.y()*xlam_[1][2] + P.z()*xlam_[1][3],
+		               P.t()*xlam_[2][0] + P.x()*xlam_[2][1] + P.y()*xlam_[2][2] + P.z()*xlam_[2][3],
+		               P.t()*xlam_[3][0] + P.x()*xlam_[3][1] + P.y()*xlam_[3][2] + P.z()*xlam_[3][3]);
+	}
+	
+	//boosting n 4-vectors stored contiguously, in place; blocks of them are gathered into t, x, y, z arrays, boosted by the vectorized form
+	//below, and scattered back
+	void apply(Vec4<T>* P, int n) const {
+		const int n_blk = 64; T t[n_blk], x[n_blk], y[n_blk], z[n_blk];
+		for(int i0=0; i0<n; i0+=n_blk){
+			Vec4<T>* Q = P + i0; int m = (n - i0 < n_blk) ? n - i0 : n_blk;
+			for(int i=0; i<m; ++i){t[i] = Q[i].t(); x[i] = Q[i].x(); y[i] = Q[i].y(); z[i] = Q[i].z();}
+			apply(t, x, y, z, m);
+			for(int i=0; i<m; ++i){Q[i] = Vec4<T>(t[i], x[i], y[i], z[i]);}
+		}
+	}
+	
+	//boosting n 4-vectors stored as separate contiguous t, x, y, z arrays, in place; this is the vectorized form
+	void apply(T* t, T* x, T* y, T* z, int n) const {
+		const T l00 = xlam_[0][0], l01 = xlam_[0][1], l02 = xlam_[0][2], l03 = xlam_[0][3];
+		const T l11 = xlam_[1][1], l12 = xlam_[1][2], l13 = xlam_[1][3];
+		const T l22 = xlam_[2][2], l23 = xlam_[2][3], l33 = xlam_[3][3];
+		#pragma omp simd
+		for(int i=0; i<n; ++i){
+			T ti = t[i]; T xi = x[i]; T yi = y[i]; T zi = z[i];
+			t[i] = ti*l00 + xi*l01 + yi*l02 + zi*l03;
+			x[i] = ti*l01 + xi*l11 + yi*l12 + zi*l13;
+			y[i] = ti*l02 + xi*l12 + yi*l22 + zi*l23;
+			z[i] = ti*l03 + xi*l13 + yi*l23 + zi*l33;
+		}
+	}
 };
 
+//single Lorentz boost functions, through a LorentzBoost built for this one vector
+template <class T> Vec4<T> Vec4<T>::boost(const Vec4& B) const {return LorentzBoost<T>(B).apply(*this);}
+template <class T> Vec4<T> Vec4<T>::boost(T vx, T vy, T vz) const {return LorentzBoost<T>(vx, vy, vz).apply(*this);}
+
 #endif //VEC4_H
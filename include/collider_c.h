@@ -0,0 +1,91 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: collider_c.h
+*
+* Description: C interface of the embeddable event generator, for linking libcollider from C or other languages
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//header guards
+#ifndef COLLIDER_C_H
+#define COLLIDER_C_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//configuration of a run, fill it with collider_config_default() and change what is needed
+//every other setting (see the README) can be given in extra as whitespace separated tag/value pairs, eg. "collkernel sorted hardcore cells"
+//no file is read or written by default; an autotuned kernel choice is only cached if extra names a tune file, eg. "tunefile output/tune.dat"
+typedef struct collider_config{
+	int n_eve; //number of events
+	int nuc_a, npro_a, nneu_a; //type (0=single nucleon, 1=deuteron, 2=heavy), protons and neutrons of nucleus a
+	int nuc_b, npro_b, nneu_b; //the same for nucleus b
+	double coll_dist; //nucleon-nucleon collision distance in fm
+	int single_prec; //nonzero to run positions and the collision kernel in single precision
+	int ecc; //nonzero to compute the eccentricities and participant plane angles of every event
+	unsigned long long seed; //RNG seed for a reproducible run (0 = seed from the system)
+	int shard_i, shard_n; //make only shard shard_i of shard_n disjoint shares of the events
+	const char* extra; //any further settings as tag/value pairs, or NULL
+} collider_config;
+
+//observables of one event
+typedef struct collider_event{
+	int index; //event number in this run, from 0
+	int n_coll, n_part; //number of binary collisions and participants
+	double area; //summed nucleon-nucleon overlap area in fm^2
+	double b_x, b_y; //impact parameter offset of nucleus b from nucleus a in fm
+	double part_cx, part_cy; //participant center in the frame of nucleus a
+	double ecc[7], psi[7]; //eccentricity and participant plane angle of orders 2 to 6 (index = order), only set if ecc is on
+} collider_event;
+
+//opaque generator handle
+typedef struct collider_gen collider_gen;
+
+//callback for collider_run, return 0 to stop the run early; user is passed through from collider_run
+typedef int (*collider_callback)(const collider_event* event, collider_gen* gen, void* user);
+
+//fills config with the default settings (the same as the Collider executable without a settings file)
+void collider_config_default(collider_config* config);
+
+//makes a generator for the configuration, free it with collider_free; returns NULL (with a message on stdout) if the configuration is bad:
+//an unrecognized tag or unreadable value in extra, bad nuclei, shard or collision profile, or a precision target (which needs histograms)
+collider_gen* collider_new(const collider_config* config);
+void collider_free(collider_gen* gen);
+
+//pull interface: generates the next event into event, returns 0 (and generates nothing) once the run is over
+int collider_next(collider_gen* gen, collider_event* event);
+//push interface: generates the remaining events, calling callback on each, returns the number of events handed to callback
+int collider_run(collider_gen* gen, collider_callback callback, void* user);
+
+//number of nucleons of nucleus a (side 0) or b (side 1)
+int collider_n_nucleons(collider_gen* gen, int side);
+//positions in fm (in the frame of their own nucleus, add b_x, b_y for nucleus b) and binary collision counts of the nucleons of nucleus
+//a (side 0) or b (side 1) of the last event (the counts are not set if "observables" in extra leaves out npart); any of the arrays may be
+//NULL, the others need collider_n_nucleons entries
+//returns the number of nucleons
+int collider_nucleons(collider_gen* gen, int side, double* x, double* y, double* z, int* hits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COLLIDER_C_H
@@ -29,8 +29,22 @@
 #include <fstream>
 #include <sstream>
 #include <ctime>
+#include <set>
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include <chrono>
 #include "Event.h"
 #include "Histogram.h"
+#include "Settings.h"
+#include "Stats.h"
+#include "Scan.h"
+#include "Grid.h"
+#include "Generator.h"
+#include "StatusFile.h"
+#include "NucleonFile.h"
+#include "Optical.h"
+#include "CrossSection.h"
 
 //Return predicted running time
 double tpred(const int n, const int nmax, const double tst) {return floor(((double)(clock() - tst)/CLOCKS_PER_SEC)*((double)(nmax)/((double)(n)) - 1.)*(1./60.) + 0.5);}
@@ -40,27 +54,12 @@ double trun(const double tst) {return floor(((double)(clock() - tst)/CLOCKS_PER_
 
 int main(int argc, char* argv[]){
 	
-	//declaring vars to use
-	int nuctypea, nuctypeb, num_pro_a, num_pro_b, num_neu_a, num_neu_b, n_eve;
-	std::string binfile_n; std::string binfile_a; std::string settingfile; std::string outfile;
-	double* binarrayN; double* binarrayA;
-	
-	//default values
-	nuctypea  = 2  ; //heavy nucleus a
-	nuctypeb  = 2  ; //heavy nucleus b
-	num_pro_a = 82 ; //number of protons in a lead 208 nucleus
-	num_pro_b = 82 ; //number of protons in a lead 208 nucleus
-	num_neu_a = 126; //number of neutrons in a lead 208 nucleus
-	num_neu_b = 126; //number of neutrons in a lead 208 nucleus
-	n_eve     = 1000; //default number of events is 10k
-	
-	binfile_n   = "settings/binfile_n.dat";
-	binfile_a   = "settings/binfile_a.dat";
-	settingfile = "settings/settings.dat";
-	outfile     = "output/output.dat";
-
+	//declaring settings to use, initialized with the default values
+	Settings settings; settings.tunefile = "output/tune.dat"; //the executable caches its kernel choices, the library default is no cache
+	std::set<std::string> setflag; //tags set on the command line, these are not overwritten by the settings file
+	
 	//reading command line arguments
-	std::string argument = ""; int nflags = 11; bool setflag[nflags]; for(int iflags=0; iflags<nflags; ++iflags){setflag[iflags]=false;}
+	std::string argument = "";
 	if(argc > 1){argument = argv[1];}
 	//listing out command line arguments, with available switches
 	if(argc%2 != 1 || argument == "-h" || argument == "-H" || argument == "-help" || argument == "-Help" || argument == "-HELP"){
@@ -77,12 +76,53 @@ int main(int argc, char* argv[]){
 		std::cout << " Switch: '-nproB' to set the number of protons in nucleus B.\n";
 		std::cout << " Switch: '-nneuA' to set the number of neutrons in nucleus A.\n";
 		std::cout << " Switch: '-nneuB' to set the number of neutrons in nucleus B.\n";
+		std::cout << " Switch: '-colldist' to set the nucleon-nucleon collision distance in fm. Default: 1.\n";
 		std::cout << " Switch: '-binfilen' to change the name of the file with binends used to histogram n_coll and n_part over the events.  " << 
 		  "Default: 'settings/binfile_n.dat'\n";
 		std::cout << " Switch: '-binfilea' to change the name of the file with binends used to histogram nucleon-nucleon overlap area over the events.  " <<
 		  "Default: 'settings/binfile_a.dat'\n";
 		std::cout << " Switch: '-setfile' to change the name of the file where settings can be read in from. Default: 'settings/settings.dat'\n";
-		std::cout << " Switch: '-outfile' to change the name of the file where the output histograms are written to. Default: 'settings/output.dat'\n";
+		std::cout << " Switch: '-outfile' to change the name of the file where the output histograms are written to. Default: 'output/output.dat'\n";
+		std::cout << " Switch: '-scanfile' to run every configuration listed in the given scan file in a single process, instead of a single run.\n";
+		std::cout << " Switch: '-precision' to run positions and the collision kernel in 'float' or 'double' precision. Default: 'double'\n";
+		std::cout << " Switch: '-validate' if set to 1, every event is also collided in the other precision and the differences are reported.\n";
+		std::cout << " Switch: '-ecc' if set to 1, the eccentricities eps_2 to eps_6 of the participants are computed and histogrammed. Default: 0\n";
+		std::cout << " Switch: '-observables' as a comma separated list of ncoll, npart, area, and midpoints (binary collision positions), or all; " <<
+		  "only these are computed (and those that -ecc, -grid, -target, or -nucfile need). Default: all\n";
+		std::cout << " Switch: '-centrality' to write centrality classes of ncoll, npart, or area (none for off) with their mean N_coll and N_part, " <<
+		  "'-centclasses' to set the number of classes, and '-centk' the size of the quantile sketch. Default: none, 10, 1000\n";
+		std::cout << " Switch: '-optical' if set to 1, the optical Glauber model is computed instead of generating events: mean N_coll, N_part, " <<
+		  "area and collision probability against b, and the minimum bias means. Default: 0\n";
+		std::cout << " Switch: '-opticalstep' to set the impact parameter step of the optical Glauber output in fm. Default: 0.5\n";
+		std::cout << " Switch: '-xsec' if set above 0, only the inelastic cross section is estimated: each of the NumE pairs of nuclei is tested " <<
+		  "at this many impact parameters, each only until its first collision. Default: 0 (off)\n";
+		std::cout << " Switch: '-grid' to write a transverse density grid for every event (0=off, 1=participants, 2=binary collisions). Default: 0\n";
+		std::cout << " Switch: '-gridsize', '-gridstep', '-gridwidth' to set the grid cells per side, cell size (fm), and source width (fm). " <<
+		  "Default: 100, 0.2, 0.5\n";
+		std::cout << " Switch: '-gridfile' to change the name of the binary file the grids are written to. Default: 'output/grid.dat'\n";
+		std::cout << " Switch: '-threads' to set the number of worker threads used in scan mode. Default: 0 (all hardware threads)\n";
+		std::cout << " Switch: '-pin' to pin the scan worker threads to CPUs, filling one NUMA node first (compact) or alternating between the nodes " <<
+		  "(scatter). Default: none\n";
+		std::cout << " Switch: '-parallel' to run the events of a scan on separate threads (events), split every event over all threads " <<
+		  "(split), or pick the faster one from the measured event cost (auto). Default: auto\n";
+		std::cout << " Switch: '-seed' to seed the random numbers for a reproducible run. Default: 0 (seeded from the system)\n";
+		std::cout << " Switch: '-shard' given as i/N, to generate only the i'th (from 0) of N disjoint, reproducible shares of the events.\n";
+		std::cout << "      The output and grid filenames get _shard<i> added, and the histogram state is written for the Merge.out tool.\n";
+		std::cout << " Switch: '-target' to stop once the relative error in every bin of the target range is below the given value. " <<
+		  "NumE is then the maximum number of events. Default: 0 (off)\n";
+		std::cout << " Switch: '-targetobs' to set the target histogram (ncoll, npart, or area), '-targeterr' to use the error of the bin " <<
+		  "entries (val) or bin means (mean), and '-targetbins' to give the bin range as lo/hi. Default: ncoll, val, 0/-1 (all bins)\n";
+		std::cout << " Switch: '-collkernel' to set the collision kernel (all, sorted, or auto to benchmark), and '-hardcore' to set the " <<
+		  "hard-core check of heavy nuclei (scan, cells, or auto). Default: auto, auto\n";
+		std::cout << " Switch: '-tunefile' to change the file the benchmarked choices are cached in. Default: 'output/tune.dat'\n";
+		std::cout << " Switch: '-statusfile' to keep a live snapshot of the progress and histograms in the given file, read with Watch.out. " <<
+		  "Default: '' (none)\n";
+		std::cout << " Switch: '-statusevery' to set the number of events between status file updates. Default: 1000\n";
+		std::cout << " Switch: '-nucfile' to write the nucleons of every event (positions, isospin, participant status) to the given binary file. " <<
+		  "Default: '' (none)\n";
+		std::cout << " Switch: '-nucres' to set the nucleon file position resolution in fm, and '-nucdelta' (0 or 1) to delta encode the positions " <<
+		  "(nucleons are then stored in order of x). Default: 0.001, 0\n";
+		std::cout << " Switch: '-statefile' to also write the binary histogram state to the given file. Default: '' (none, or <outfile>.state for shards)\n";
 		std::cout << " Notes:\n";
 		std::cout << " Any parameters set here will overwrite any defaults or settings in the code proper, or those read from a settings file.\n";
 		std::cout << " There are no explicit catches for bad values; some may catch, but expect undefined behaviour.\n\n";
@@ -92,90 +132,129 @@ int main(int argc, char* argv[]){
 	else{
 		for (int i=1; i<argc; i+=2){
 			argument = argv[i];
-			if(     argument == "-NumE"    ){n_eve       = std::stoi(argv[i+1]); setflag[0]  = true;}
-			else if(argument == "-nucA"    ){nuctypea    = std::stoi(argv[i+1]); setflag[1]  = true;}
-			else if(argument == "-nucB"    ){nuctypeb    = std::stoi(argv[i+1]); setflag[2]  = true;}
-			else if(argument == "-nproA"   ){num_pro_a   = std::stoi(argv[i+1]); setflag[3]  = true;}
-			else if(argument == "-nproB"   ){num_pro_b   = std::stoi(argv[i+1]); setflag[4]  = true;}
-			else if(argument == "-nneuA"   ){num_neu_a   = std::stoi(argv[i+1]); setflag[5]  = true;}
-			else if(argument == "-nneuB"   ){num_neu_b   = std::stoi(argv[i+1]); setflag[6]  = true;}
-			else if(argument == "-binfilen"){binfile_n   = argv[i+1];            setflag[7]  = true;}
-			else if(argument == "-binfilea"){binfile_a   = argv[i+1];            setflag[8]  = true;}
-			else if(argument == "-setfile" ){settingfile = argv[i+1];            setflag[9]  = true;}
-			else if(argument == "-outfile" ){outfile     = argv[i+1];            setflag[10] = true;}
+			bool is_switch = !argument.empty() && (argument[0] == '-'); std::string tag = is_switch ? argument.substr(1) : "";
+			if(is_switch && settings.set(tag, argv[i+1])){setflag.insert(tag);}
 			else{std::cout << " Switch " << argument << " was not recognized.\nFor help, run with -h switch.\nPress enter to continue running.\n"; std::cin >> argument;}
 		}
 	}
 	
 	//need to read-in and parse settings file.  Then overwrite default values with values there, but ONLY if it wasn't already overridden on command line
-	std::ifstream settings (settingfile.c_str());
-	std::stringstream argstream;
-	while(std::getline(settings, argument)){
-		//lines beginning with # denote comments
-		if((argument.front() == '#') || (argument.empty())){continue;}
-		
-		//parsing line into 2 strings
-		argstream << argument;
-		std::string str1; std::string str2;
-		argstream << str1 << str2;
-		
-		//if first string matches an argument, set the appropriate value to the second string IFF it wasnt' set on command line
-		if(     str1 == "NumE"     && !setflag[0] ){n_eve       = std::stoi(str2);}
-		else if(str1 == "nucA"     && !setflag[1] ){nuctypea    = std::stoi(str2);}
-		else if(str1 == "nucB"     && !setflag[2] ){nuctypeb    = std::stoi(str2);}
-		else if(str1 == "nproA"    && !setflag[3] ){num_pro_a   = std::stoi(str2);}
-		else if(str1 == "nproB"    && !setflag[4] ){num_pro_b   = std::stoi(str2);}
-		else if(str1 == "nneuA"    && !setflag[5] ){num_neu_a   = std::stoi(str2);}
-		else if(str1 == "nneuB"    && !setflag[6] ){num_neu_b   = std::stoi(str2);}
-		else if(str1 == "binfilen" && !setflag[7] ){binfile_n   = str2;           }
-		else if(str1 == "binfilea" && !setflag[8] ){binfile_a   = str2;           }
-		else if(str1 == "outfile"  && !setflag[10]){outfile     = str2;           }
+	settings.read(settings.settingfile, setflag);
+	
+	//checking the shard, each shard gets its own output files
+	if((settings.shard_n < 1) || (settings.shard_i < 0) || (settings.shard_i >= settings.shard_n)){
+		std::cout << "\n\nThe shard must be given as i/N with 0 <= i < N.\n\n";
+		exit(EXIT_FAILURE);
+	}
+	if(settings.shard_n > 1){
+		std::string tagname = "_shard" + std::to_string(settings.shard_i);
+		settings.outfile = Settings::tag_file(settings.outfile, tagname); settings.gridfile = Settings::tag_file(settings.gridfile, tagname);
+		if(settings.statefile.empty()){settings.statefile = settings.outfile + ".state";}
+	}
+	
+	//the single run features that scan mode does not support (Scan checks the same on every line of the scan file)
+	if(!settings.scanfile.empty() && !settings.scan_conflict().empty()){std::cout << "\n\n" << settings.scan_conflict() << "\n\n"; exit(EXIT_FAILURE);}
+	
+	if((settings.grid_mode > 0) && ((settings.grid_n < 1) || (settings.grid_step <= 0.) || (settings.grid_width <= 0.))){
+		std::cout << "\n\nThe grid size, step and width must be positive.\n\n"; exit(EXIT_FAILURE);
+	}
+	
+	if(settings.status_every < 1){std::cout << "\n\nThe status file must be updated at least every event (statusevery >= 1).\n\n"; exit(EXIT_FAILURE);}
+	
+	if(settings.optical && (settings.opt_step <= 0.)){std::cout << "\n\nThe optical Glauber impact parameter step must be positive.\n\n"; exit(EXIT_FAILURE);}
+	if(settings.xsec < 0){std::cout << "\n\nThe impact parameters per pair of nuclei of the cross section mode must not be negative.\n\n"; exit(EXIT_FAILURE);}
+	if((settings.xsec > 0) && (settings.shard_n > 1)){
+		std::cout << "\n\nThe cross section mode is not supported with shards.\n\n"; exit(EXIT_FAILURE);
+	}
+	
+	//in scan mode, every configuration in the scan file is run together and the single run settings only act as the defaults
+	if(!settings.scanfile.empty()){
+		Scan scan(settings);
+		scan.run(settings.n_threads, settings.pin, settings.parallel);
+		return 0;
+	}
+	
+	//the configuration checks of the generator, which reports them instead of exiting since it is also the library
+	if(!Generator::check(settings).empty()){std::cout << "\n\n" << Generator::check(settings) << "\n\n"; exit(EXIT_FAILURE);}
+	
+	//optical Glauber mode: the means against impact parameter are integrated directly, no events are generated
+	if(settings.optical){
+		auto tstart_opt = std::chrono::steady_clock::now();
+		Optical optical(settings); optical.write(settings.outfile, settings.opt_step); Optical::Point mb = optical.min_bias();
+		std::cout << "\n\nOptical Glauber output written to file: " << settings.outfile << "\n";
+		std::cout << "Optical Glauber: sigma_inel = " << optical.sigma_inel() << " fm^2, minimum bias <N_coll> = " << mb.n_coll << ", <N_part> = " <<
+		  mb.n_part << ", <Area> = " << mb.area << " fm^2\n";
+		std::cout << "Time taken was " << std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart_opt).count()*1000. << " ms\n\n";
+		return 0;
+	}
+	
+	//fast cross section mode: each pair of nuclei is tested at many impact parameters with early exit collision tests, no events are made
+	if(settings.xsec > 0){
+		auto tstart_xs = std::chrono::steady_clock::now();
+		Generator generator(settings); Event& event = generator.event(); CrossSection xsec;
+		for(int i_eve=0; i_eve<generator.n_eve(); ++i_eve){
+			double area = 0.; int hits = event.xsec_trials(settings.xsec, area);
+			xsec.add(settings.xsec, hits, area*hits/settings.xsec, area);
+		}
+		std::ofstream fileout(settings.outfile.c_str()); xsec.write(fileout); fileout.close();
+		std::cout << "\n\nCross section output written to file: " << settings.outfile << "\n";
+		std::cout << "Inelastic cross section: sigma_inel = " << xsec.sigma() << " +- " << xsec.err() << " fm^2 (" << 10.*xsec.sigma() << " +- " <<
+		  10.*xsec.err() << " mb), from " << xsec.n_samples() << " pairs of nuclei and " << xsec.n_trials() << " impact parameters (" << xsec.n_hits() <<
+		  " with a collision)\n";
+		std::cout << "Time taken was " << std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart_xs).count()*1000. << " ms\n\n";
+		return 0;
 	}
 	
 	//reporting current settings
 	std::string nA = "A"; std::string nB = "A";
-	if(     nuctypea == 0){nA="p";}
-	else if(nuctypea == 1){nA="d";}
+	if(     settings.nuctypea == 0){nA="p";}
+	else if(settings.nuctypea == 1){nA="d";}
 	
-	if(     nuctypeb == 0){nB="p";}
-	else if(nuctypeb == 1){nB="d";}
+	if(     settings.nuctypeb == 0){nB="p";}
+	else if(settings.nuctypeb == 1){nB="d";}
 	
 	std::cout << "\n\n";
-	std::cout << "Running " << n_eve << " " << nA << "+" << nB << " Events (" << num_pro_a << " protons and " << num_neu_a <<
-	  " neutrons against " << num_pro_b << " protons and " << num_neu_b << " neutrons" << ").\n";
-	std::cout << "Bin ends for collision statistics are :" << binfile_n << " and " << binfile_a << "\n";
-	std::cout << "Output written to file: " << outfile << "\n";
+	std::cout << "Running " << settings.n_eve << " " << nA << "+" << nB << " Events (" << settings.num_pro_a << " protons and " << settings.num_neu_a <<
+	  " neutrons against " << settings.num_pro_b << " protons and " << settings.num_neu_b << " neutrons" << ").\n";
+	std::cout << "Bin ends for collision statistics are :" << settings.binfile_n << " and " << settings.binfile_a << "\n";
+	std::cout << "Output written to file: " << settings.outfile << "\n";
+	if(settings.shard_n > 1){std::cout << "Shard " << settings.shard_i << " of " << settings.shard_n << ", state written to file: " << settings.statefile << "\n";}
 	std::cout << "\n\n";
 	
 	//setting up histograms
 	//first, need to read in binfiles
-	//determining the number of bins from file
-	std::ifstream binningN(binfile_n.c_str()); std::ifstream binningA(binfile_a.c_str()); std::string line;
-	int nbinsN = 0; int nbinsA = 0;
-	while(std::getline(binningN, line)){nbinsN++;} while(std::getline(binningA, line)){nbinsA++;}
-	binningN.close(); binningN.clear(); binningA.close(); binningA.clear();
+	std::vector<double> binarrayN = Settings::read_bins(settings.binfile_n); std::vector<double> binarrayA = Settings::read_bins(settings.binfile_a);
 	
-	//Allocating binarray
-	binarrayN = new double[nbinsN]; binarrayA = new double[nbinsA];
+	//the generator makes the events of this run (this shard's share of NumE), with the kernel choice, seeding, validation and adaptive
+	//stopping; this loop only reports progress and writes the outputs
+	Generator generator(settings); generator.histogram(binarrayN, binarrayA);
+	Event& event = generator.event(); Stats& stats = generator.stats();
+	std::cout << generator.tuning() << "\n\n";
 	
-	//reading into binarray with bin values from file
-	nbinsN = 0; nbinsA = 0; double binval = 0.;
-	binningN.open(binfile_n.c_str()); binningA.open(binfile_a.c_str());
-	while(binningN >> binval){binarrayN[nbinsN]=binval; nbinsN++;} while(binningA >> binval){binarrayA[nbinsA]=binval; nbinsA++;}
-	binningN.close(); binningA.close();
+	//transverse grid, written for every event to a binary file
+	std::unique_ptr<Grid> grid; std::ofstream gridout;
+	if(settings.grid_mode > 0){
+		grid.reset(new Grid(settings.grid_n, settings.grid_step, settings.grid_width));
+		gridout.open(settings.gridfile.c_str(), std::ios::binary); grid->write_header(gridout, settings.grid_mode);
+	}
 	
-	//declaring histograms
-	//Using double histograms for the double ones because I want double binends to make the bin centers fall exactly on integer values
-	Histogram<double> h_n_coll(binarrayN, nbinsN-1); Histogram<double> h_n_part(binarrayN, nbinsN-1); Histogram<double> h_area(binarrayA, nbinsA-1);
+	//live status file, rewritten every status_every events with the histograms so far
+	std::unique_ptr<StatusFile> status; auto twall = std::chrono::steady_clock::now();
+	if(!settings.statusfile.empty()){status.reset(new StatusFile(settings.statusfile, stats, generator.n_eve()));}
 	
-	//declaring event object
-	Event event(nuctypea, num_pro_a, num_neu_a, nuctypeb, num_pro_b, num_neu_b);
+	//nucleon file, every event's nucleons are encoded here and written out in the background
+	std::unique_ptr<NucleonWriter> nucout;
+	if(!settings.nucfile.empty()){nucout.reset(new NucleonWriter(settings.nucfile, settings.nuc_res, settings.nuc_delta, event.nuc_a().size(), event.nuc_b().size()));}
 	
 	//event loop
 	clock_t tstart = clock();
-	for(int i_eve=0; i_eve<n_eve; ++i_eve){
-		event.gen(); //generating a single event
-		h_n_coll.fill(event.n_coll()); h_n_part.fill(event.n_part()); h_area.fill(event.area()); //filling histograms with statistical info.
+	while(generator.next()){
+		int i_eve = generator.i_eve() - 1; int n_eve = generator.n_eve();
+		if(settings.grid_mode > 0){grid->clear(); event.deposit(*grid, settings.grid_mode); grid->write(gridout);} //smearing sources onto the grid
+		if(nucout){nucout->write(event);}
+		if(status && ((i_eve+1)%settings.status_every == 0)){
+			status->update(stats, i_eve+1, n_eve, std::chrono::duration<double>(std::chrono::steady_clock::now() - twall).count());
+		}
 		
 		//keeping track of progress and time; estimating time remaining; reporting every 1000 events
 		if(i_eve%100==0){
@@ -185,40 +264,37 @@ int main(int argc, char* argv[]){
 			std::cout << "  Avg. # events / sec: " << i_eve/((double)(clock() - tstart)/CLOCKS_PER_SEC) << "\n\n";
 		}
 	}
+	int n_eve = generator.n_eve();
+	nucout.reset(); //the index is written when the nucleon file is closed
+	if(status){status->update(stats, n_eve, n_eve, std::chrono::duration<double>(std::chrono::steady_clock::now() - twall).count(), true);}
 	
 	//Event loop completion message
 	std::cout << "All requested events have been generated.  Writing out statistics and closing.\n\n";
 	std::cout << "\nTime taken was " << ((double)(clock() - tstart)/CLOCKS_PER_SEC)/60. << " minutes \n";
 	std::cout << "Average time per event was " << ((double)(clock() - tstart)/CLOCKS_PER_SEC)/n_eve << " seconds \n";
 	std::cout << "Avg. # events / sec: " << n_eve/((double)(clock() - tstart)/CLOCKS_PER_SEC) << "\n";
+	std::cout << "\nInelastic cross section from the sampled impact parameters: " << stats.xsec().sigma() << " +- " << stats.xsec().err() << " fm^2 (" <<
+	  10.*stats.xsec().sigma() << " +- " << 10.*stats.xsec().err() << " mb), " << stats.xsec().n_trials() << " impact parameters for " << n_eve << " events\n";
 	
-	//opening up output file to write histograms to
-	std::ofstream fileout(outfile.c_str());
-	
-	//writing to file
-	fileout << "\n";
-	fileout << "N_coll Histogram:";
-	fileout << "N_coll, Entries";
-	for(int ihist=0; ihist<h_n_coll.n_bins(); ++ihist){
-		fileout << h_n_coll.mean_bin(ihist) << ", " << h_n_coll.val_bin(ihist) << "\n";
+	//adaptive stopping report
+	if(settings.target > 0.){
+		double target_err = generator.check_target();
+		std::cout << "\nPrecision target " << settings.target << (generator.target_reached() ? " reached" : " NOT reached") <<
+		  " after " << n_eve << " events: largest relative error " << target_err << "\n";
 	}
-	fileout << "\n\n\n\n\n\n\n\n\n\n";
-	fileout << "N_part Histogram:";
-	fileout << "N_part, Entries";
-	for(int ihist=0; ihist<h_n_part.n_bins(); ++ihist){
-		fileout << h_n_part.mean_bin(ihist) << ", " << h_n_part.val_bin(ihist) << "\n";
-	}
-	fileout << "\n\n\n\n\n\n\n\n\n\n";
-	fileout << "Area Histogram:";
-	fileout << "bin_AvgArea, Entries";
-	for(int ihist=0; ihist<h_area.n_bins(); ++ihist){
-		fileout << h_area.mean_bin(ihist) << ", " << h_area.val_bin(ihist) << "\n";
-	}
-	fileout.close();
 	
+	//precision validation report
+	if(settings.validate){
+		std::cout << "\nPrecision validation (" << (settings.single_prec ? "float" : "double") << " kept, compared against " <<
+		  (settings.single_prec ? "double" : "float") << " on the same nuclei and impact parameter stream):\n";
+		std::cout << "  Events with differing N_coll: " << generator.n_diff_coll() << " (" << ((double)generator.n_diff_coll()/n_eve)*100. << "%)\n";
+		std::cout << "  Events with differing N_part: " << generator.n_diff_part() << " (" << ((double)generator.n_diff_part()/n_eve)*100. << "%)\n";
+		std::cout << "  Relative area difference: max " << generator.max_diff_area() << ", mean " << generator.mean_diff_area() << "\n";
+	}
 	
-	//releasing memory
-	delete [] binarrayN; delete [] binarrayA;
+	//writing histograms to the output file, and their binary state for merging if requested
+	stats.write(settings.outfile);
+	if(!settings.statefile.empty()){stats.write_state(settings.statefile);}
 	
 return 0;
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: CrossSection.cpp
+*
+* Description: Inelastic cross section estimate from sampled impact parameters, with its statistical error
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <cmath>
+#include "CrossSection.h"
+
+//reading an estimate back from its binary state, in the order written by write_state
+CrossSection::CrossSection(std::istream& in) : n_samp_(0), n_trials_(0), n_hits_(0), sum_(0.), sum2_(0.), area_sum_(0.) {
+	in.read((char*)&n_samp_, sizeof(n_samp_)); in.read((char*)&n_trials_, sizeof(n_trials_)); in.read((char*)&n_hits_, sizeof(n_hits_));
+	in.read((char*)&sum_, sizeof(sum_)); in.read((char*)&sum2_, sizeof(sum2_)); in.read((char*)&area_sum_, sizeof(area_sum_));
+}
+
+//writing the binary state
+void CrossSection::write_state(std::ostream& out) const {
+	out.write((const char*)&n_samp_, sizeof(n_samp_)); out.write((const char*)&n_trials_, sizeof(n_trials_)); out.write((const char*)&n_hits_, sizeof(n_hits_));
+	out.write((const char*)&sum_, sizeof(sum_)); out.write((const char*)&sum2_, sizeof(sum2_)); out.write((const char*)&area_sum_, sizeof(area_sum_));
+}
+
+//standard error of the mean of the samples
+double CrossSection::err() const {
+	if(n_samp_ < 2){return 0.;}
+	double mean = sum_/n_samp_; double var = (sum2_/n_samp_ - mean*mean)*n_samp_/(n_samp_ - 1.);
+	
+return (var > 0.) ? std::sqrt(var/n_samp_) : 0.;
+}
+
+//writing the estimate as an output file section
+void CrossSection::write(std::ostream& out) const {
+	out << "\n\n\n\n\n\n\n\n\n\n";
+	out << "Inelastic Cross Section:";
+	out << "Sigma_inel (fm^2), Error (fm^2), Sigma_inel (mb), Error (mb), Samples, Trials, Hits, AvgSampledArea (fm^2)";
+	out << sigma() << ", " << err() << ", " << 10.*sigma() << ", " << 10.*err() << ", " << n_samp_ << ", " << n_trials_ << ", " << n_hits_ << ", " << mean_area() << "\n";
+}
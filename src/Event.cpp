@@ -25,74 +25,636 @@
 ***************************************************************************************************************************************************/
 
 //includes here
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
 #include <vector>
-#include <random>
+#include <algorithm>
 #include "Event.h"
 #include "Nucleus.h"
 #include "Nucleon.h"
 
-//return random double between 0 and 1
-double Event::ran() {std::uniform_real_distribution<double> uniran(0.,1.); return uniran(eng);}
+//constructor; the nuclei are built once here and only refilled for each event
+Event::Event(int a_type_in, int a_npro_in, int a_nneu_in, int b_type_in, int b_npro_in, int b_nneu_in, double coll_dist_in) :
+  nuc_a_(a_type_in, a_npro_in, a_nneu_in), nuc_b_(b_type_in, b_npro_in, b_nneu_in) {
+	a_type_ = a_type_in; a_npro_ = a_npro_in; a_nneu_ = a_nneu_in; b_type_ = b_type_in; b_npro_ = b_npro_in; b_nneu_ = b_nneu_in;
+	coll_dist_ = coll_dist_in;
+	reset(); last_a_ = nullptr; last_b_ = nullptr;
+	
+	//kernel buffers
+	pos_d_.ax.resize(a_npro_+a_nneu_); pos_d_.ay.resize(a_npro_+a_nneu_); pos_d_.bx.resize(b_npro_+b_nneu_); pos_d_.by.resize(b_npro_+b_nneu_);
+	pos_f_.ax.resize(a_npro_+a_nneu_); pos_f_.ay.resize(a_npro_+a_nneu_); pos_f_.bx.resize(b_npro_+b_nneu_); pos_f_.by.resize(b_npro_+b_nneu_);
+	a_hits_.resize(a_npro_+a_nneu_); b_hits_.resize(b_npro_+b_nneu_);
+	a_part_.resize((a_npro_+a_nneu_+63)/64); b_part_.resize((b_npro_+b_nneu_+63)/64);
+	s_hits_.resize(std::max(a_npro_+a_nneu_, b_npro_+b_nneu_));
+	coll_x_.reserve(64); coll_y_.reserve(64); part_x_.reserve(a_npro_+a_nneu_+b_npro_+b_nneu_); part_y_.reserve(a_npro_+a_nneu_+b_npro_+b_nneu_);
+	
+	//double precision and all pairs by default, without eccentricities or hotspots
+	strategy_ = 0; n_hs_ = 0; hs_dist_ = 0.; hs_width_ = 0.; obs_ = OBS_ALL; ecc_ = false; pool_ = nullptr; single(false); profile(0, 1.);
+	cand_.resize(std::max(a_npro_+a_nneu_, b_npro_+b_nneu_)); prob_hit_.resize(cand_.size());
+	for(int n=0; n<=6; n++){ecc_n_[n] = 0.; psi_n_[n] = 0.;}
+}
+
+//picking the collision kernel for this pair of nucleus types (already checked to be 0, 1, or 2 by the Nucleus constructor), precision and strategy
+//and the observables it computes; eccentricities are computed from the participants, so they need them
+void (Event::*Event::kernel(bool single_in, int strategy_in))(Nucleus&, Nucleus&){
+	if(n_hs_ > 0){return single_in ? &Event::collide_hs<float> : &Event::collide_hs<double>;}
+	
+	switch(obs_ | (ecc_ ? OBS_NPART : 0)){
+		case 0: return kernel_o<0>(single_in, strategy_in);
+		case 1: return kernel_o<1>(single_in, strategy_in);
+		case 2: return kernel_o<2>(single_in, strategy_in);
+		case 3: return kernel_o<3>(single_in, strategy_in);
+		case 4: return kernel_o<4>(single_in, strategy_in);
+		case 5: return kernel_o<5>(single_in, strategy_in);
+		case 6: return kernel_o<6>(single_in, strategy_in);
+		default: return kernel_o<7>(single_in, strategy_in);
+	}
+}
+
+//the kernel table of one set of observables O
+template<int O> void (Event::*Event::kernel_o(bool single_in, int strategy_in))(Nucleus&, Nucleus&){
+	static void (Event::*const kernels[2][2][3][3])(Nucleus&, Nucleus&) = {
+		{
+		 {{&Event::collide_t<double,0,0,0,O>, &Event::collide_t<double,0,1,0,O>, &Event::collide_t<double,0,2,0,O>},
+		  {&Event::collide_t<double,1,0,0,O>, &Event::collide_t<double,1,1,0,O>, &Event::collide_t<double,1,2,0,O>},
+		  {&Event::collide_t<double,2,0,0,O>, &Event::collide_t<double,2,1,0,O>, &Event::collide_t<double,2,2,0,O>}},
+		 {{&Event::collide_t<float,0,0,0,O>, &Event::collide_t<float,0,1,0,O>, &Event::collide_t<float,0,2,0,O>},
+		  {&Event::collide_t<float,1,0,0,O>, &Event::collide_t<float,1,1,0,O>, &Event::collide_t<float,1,2,0,O>},
+		  {&Event::collide_t<float,2,0,0,O>, &Event::collide_t<float,2,1,0,O>, &Event::collide_t<float,2,2,0,O>}}},
+		{
+		 {{&Event::collide_t<double,0,0,1,O>, &Event::collide_t<double,0,1,1,O>, &Event::collide_t<double,0,2,1,O>},
+		  {&Event::collide_t<double,1,0,1,O>, &Event::collide_t<double,1,1,1,O>, &Event::collide_t<double,1,2,1,O>},
+		  {&Event::collide_t<double,2,0,1,O>, &Event::collide_t<double,2,1,1,O>, &Event::collide_t<double,2,2,1,O>}},
+		 {{&Event::collide_t<float,0,0,1,O>, &Event::collide_t<float,0,1,1,O>, &Event::collide_t<float,0,2,1,O>},
+		  {&Event::collide_t<float,1,0,1,O>, &Event::collide_t<float,1,1,1,O>, &Event::collide_t<float,1,2,1,O>},
+		  {&Event::collide_t<float,2,0,1,O>, &Event::collide_t<float,2,1,1,O>, &Event::collide_t<float,2,2,1,O>}}}
+	};
+	
+return kernels[strategy_in == 1 ? 1 : 0][single_in ? 1 : 0][a_type_][b_type_];
+}
+
+//hotspot mode, sizing the hotspot buffers and picking the hotspot kernel
+void Event::hotspots(int n_hs, double dist, double width){
+	n_hs_ = (n_hs > 0) ? n_hs : 0; hs_dist_ = dist; hs_width_ = width;
+	int n_a = a_npro_+a_nneu_; int n_b = b_npro_+b_nneu_;
+	a_hs_hits_.assign(n_a*n_hs_, 0); b_hs_hits_.assign(n_b*n_hs_, 0);
+	pos_d_.hax.resize(n_a*n_hs_); pos_d_.hay.resize(n_a*n_hs_); pos_d_.hbx.resize(n_b*n_hs_); pos_d_.hby.resize(n_b*n_hs_); pos_d_.ra.resize(n_a); pos_d_.rb.resize(n_b);
+	pos_f_.hax.resize(n_a*n_hs_); pos_f_.hay.resize(n_a*n_hs_); pos_f_.hbx.resize(n_b*n_hs_); pos_f_.hby.resize(n_b*n_hs_); pos_f_.ra.resize(n_a); pos_f_.rb.resize(n_b);
+	kernel_ = kernel(single_, strategy_);
+}
+
+//collision probability profile, and the cutoff distance past which a pair can never collide
+void Event::profile(int type, double amp){
+	if((type < 0) || (type > 2) || (amp <= 0.) || (amp > 1.)){
+		std::cout << "\n\nThe collision profile must be 0, 1, or 2, with an amplitude in (0,1].\n\n"; exit(EXIT_FAILURE);
+	}
+	profile_ = type; prof_amp_ = (type == 0) ? 1. : amp; prof_k_ = prof_amp_/(coll_dist_*coll_dist_);
+	if(type == 0){r_cut_ = coll_dist_;}
+	else if(type == 1){r_cut_ = coll_dist_/std::sqrt(prof_amp_);}
+	else{r_cut_ = std::sqrt(std::max(std::log(prof_amp_/prof_eps_), 0.)/prof_k_);}
+}
 
 //generate a single event by populating nuclei, colliding them, counting collision statistics
 void Event::gen(){
+	//fill nuclei
+	nuc_a_.fill(); nuc_b_.fill();
 	
-	//resetting event - clearing to ensure clean slate for new event
-	reset();
+	//collide them
+	collide(nuc_a_, nuc_b_);
+}
+
+//fast inelastic cross section sampling, many impact parameters for one pair of nuclei, each tested only until its first collision
+int Event::xsec_trials(int n_b, double& area){
+	const int n_a = a_npro_+a_nneu_; const int n_bn = b_npro_+b_nneu_;
+	nuc_a_.fill(); nuc_b_.fill();
+	
+	//gathering the positions (and sampling the hotspots), with the same impact parameter bound as the event loop
+	Coords<double>& p = pos_d_;
+	for(int inuc_a=0; inuc_a<n_a; inuc_a++){p.ax[inuc_a] = nuc_a_[inuc_a].x(); p.ay[inuc_a] = nuc_a_[inuc_a].y();}
+	for(int inuc_b=0; inuc_b<n_bn; inuc_b++){p.bx[inuc_b] = nuc_b_[inuc_b].x(); p.by[inuc_b] = nuc_b_[inuc_b].y();}
+	double reach = r_cut_;
+	if(n_hs_ > 0){
+		sample_hs(p.hax, p.hay, p.ra, n_a); sample_hs(p.hbx, p.hby, p.rb, n_bn);
+		reach = *std::max_element(p.ra.begin(), p.ra.end()) + *std::max_element(p.rb.begin(), p.rb.end());
+	}
+	double r_max = maxrad(p.ax.data(), p.ay.data(), n_a) + maxrad(p.bx.data(), p.by.data(), n_bn) + reach;
+	area = pi*r_max*r_max;
+	
+	int hits = 0;
+	for(int ib=0; ib<n_b; ib++){
+		double r_samp = std::sqrt(r_max*r_max*ran()); double cos_th, sin_th; rng_.azimuth(cos_th, sin_th);
+		hits += any_coll(r_samp*cos_th, r_samp*sin_th);
+	}
+	
+return hits;
+}
+
+//if nucleus b, offset by (offset_x, offset_y), has any collision with nucleus a; each nucleon of a is one vectorized scan over b (a count, so
+//it vectorizes), and the scan stops at the first nucleon of a with a collision
+//the probabilistic profiles draw only for the pairs within the cutoff, stopping at the first that collides, and hotspot mode tests the hotspot
+//pairs of the nucleon pairs within reach of each other
+bool Event::any_coll(double offset_x, double offset_y){
+	const int n_a = a_npro_+a_nneu_; const int n_b = b_npro_+b_nneu_; const int nh = n_hs_;
+	Coords<double>& p = pos_d_; const double* bx = p.bx.data(); const double* by = p.by.data();
+	const double rc2 = r_cut_*r_cut_; const double hd2 = hs_dist_*hs_dist_; int* cand = cand_.data();
 	
-	//declare nuclei
-	Nucleus nuc_a(a_type_, a_npro_, a_nneu_); Nucleus nuc_b(b_type_, b_npro_, b_nneu_);
+	for(int ia=0; ia<n_a; ia++){
+		double x = p.ax[ia] - offset_x; double y = p.ay[ia] - offset_y;
+		if((nh == 0) && (profile_ == 0)){
+			int hits = 0;
+			#pragma omp simd reduction(+:hits)
+			for(int ib=0; ib<n_b; ib++){hits += ((x - bx[ib])*(x - bx[ib]) + (y - by[ib])*(y - by[ib]) <= rc2);}
+			if(hits > 0){return true;}
+			continue;
+		}
+		
+		//candidates within the cutoff (or the reach of both nucleons in hotspot mode)
+		int n_cand = 0;
+		for(int ib=0; ib<n_b; ib++){
+			double dx = x - bx[ib]; double dy = y - by[ib]; double reach = (nh > 0) ? p.ra[ia] + p.rb[ib] : r_cut_;
+			cand[n_cand] = ib; n_cand += (dx*dx + dy*dy <= reach*reach);
+		}
+		for(int icand=0; icand<n_cand; icand++){
+			int ib = cand[icand];
+			if(nh == 0){
+				double dist2 = (x - bx[ib])*(x - bx[ib]) + (y - by[ib])*(y - by[ib]);
+				double prob = (profile_ == 1) ? prof_amp_ : prof_amp_*std::exp(-prof_k_*dist2);
+				if(ran() < prob){return true;}
+				continue;
+			}
+			const double* hbx = &p.hbx[ib*nh]; const double* hby = &p.hby[ib*nh];
+			for(int ka=0; ka<nh; ka++){
+				double hx = x + p.hax[ia*nh+ka] - bx[ib]; double hy = y + p.hay[ia*nh+ka] - by[ib]; int hits = 0;
+				#pragma omp simd reduction(+:hits)
+				for(int kb=0; kb<nh; kb++){hits += ((hx - hbx[kb])*(hx - hbx[kb]) + (hy - hby[kb])*(hy - hby[kb]) <= hd2);}
+				if(hits > 0){return true;}
+			}
+		}
+	}
 	
+return false;
+}
+
+//generate a single event, colliding the same nuclei in both precisions from the same impact parameter random stream
+void Event::gen_check(int& n_coll_other, int& n_part_other, double& area_other){
 	//fill nuclei
-	nuc_a.fill(); nuc_b.fill();
+	nuc_a_.fill(); nuc_b_.fill();
+	
+	//colliding in the other precision first, then rewinding the RNG so this precision sees the same impact parameters
+	Random rng_start = rng_;
+	(this->*kernel(!single_, strategy_))(nuc_a_, nuc_b_);
+	n_coll_other = num_coll_; n_part_other = num_part_; area_other = area_tot_;
+	rng_ = rng_start;
+	collide(nuc_a_, nuc_b_);
+}
+
+//collide two already filled nuclei, counting collision statistics
+template<class T, int TA, int TB, int S, int O> void Event::collide_t(Nucleus& nuc_a, Nucleus& nuc_b){
+	//which observables are computed, fixed at compile time
+	const bool PART = (O & OBS_NPART) != 0;
+	//number of nucleons; fixed at compile time for single nucleons and deuterons
+	const int NA = NucleusSize<TA>::value; const int NB = NucleusSize<TB>::value;
+	const int n_a = (NA > 0) ? NA : a_npro_+a_nneu_; const int n_b = (NB > 0) ? NB : b_npro_+b_nneu_;
+	
+	//resetting event - clearing to ensure clean slate for new event
+	reset(); last(nuc_a, nuc_b);
+	
+	//gathering the transverse positions into the kernel buffers of this precision
+	Coords<T>& p = pos(T());
+	for(int inuc_a=0; inuc_a<n_a; inuc_a++){p.ax[inuc_a] = T(nuc_a[inuc_a].x()); p.ay[inuc_a] = T(nuc_a[inuc_a].y());}
+	for(int inuc_b=0; inuc_b<n_b; inuc_b++){p.bx[inuc_b] = T(nuc_b[inuc_b].x()); p.by[inuc_b] = T(nuc_b[inuc_b].y());}
+	
+	//no pair of nucleons can be further apart than the sum of the furthest nucleon in each nucleus, so this bounds the impact parameter
+	//(any impact parameter bound past the last possible collision gives the same accepted events, this one just avoids a pass over all pairs)
+	//additional coll_dist to push to the very extreme edge of the furthest nucleons in the nuclei
+	double r_max = maxrad(p.ax.data(), p.ay.data(), n_a) + maxrad(p.bx.data(), p.by.data(), n_b) + r_cut_;
+	b_area_ = pi*r_max*r_max;
+	
+	//the heavy nucleus is always the inner one of the pair loop: a if a is heavy and b is not, b otherwise
+	//with the sorted strategy and a heavy inner nucleus, it is sorted in x once here (the impact parameter shift does not change the order)
+	const bool A_INNER = (NA == 0) && (NB > 0); const bool W = (S == 1) && (A_INNER || (NB == 0));
+	const int n_i = A_INNER ? n_a : n_b;
+	const T* xi = A_INNER ? p.ax.data() : p.bx.data(); const T* yi = A_INNER ? p.ay.data() : p.by.data(); int* hits_i = A_INNER ? a_hits_.data() : b_hits_.data();
+	if(W){sort_inner(p, xi, yi, n_i); xi = p.sx.data(); yi = p.sy.data(); hits_i = s_hits_.data();}
 	
 	//while loop to allow for resampling of collision geometries until a collision happens
 	bool good_coll = false;
 	while(!good_coll){
 		//generate an impact parameter, is this a glancing blow or head-on?
 		//sample r^2 from 0 to max_dist between any nucleon in A and any nucleon in B
-		double r_max = maxdist(nuc_a, nuc_b) + 1.; //additional 1. fm to push to the very extreme edge of the furthest nucleons in the nuclei
 		double r_min = 0.; //later can allow for this and/or above to be settings for centrality bin / impact parameter studies
-		double r_samp = sqrt(r_max*r_max - (r_max*r_max - r_min*r_min)*ran());
-		double th = ran()*2.*pi;
+		double r_samp = sqrt(r_max*r_max - (r_max*r_max - r_min*r_min)*ran()); ++trials_;
+		double cos_th, sin_th; rng_.azimuth(cos_th, sin_th);
 		
 		//finding the offset for 2nd nucleus (arbitrary) for the collision
-		double offset_x = r_samp*cos(th);
-		double offset_y = r_samp*sin(th);
+		double offset_x = r_samp*cos_th;
+		double offset_y = r_samp*sin_th;
+		
+		//clearing per-nucleon collision counts and the binary collision list
+		if(PART){
+			for(int inuc_a=0; inuc_a<n_a; inuc_a++){a_hits_[inuc_a] = 0;}
+			for(int inuc_b=0; inuc_b<n_b; inuc_b++){b_hits_[inuc_b] = 0;}
+			if(W){for(int inuc=0; inuc<n_i; inuc++){s_hits_[inuc] = 0;}}
+		}
+		coll_x_.clear(); coll_y_.clear();
 		
-		//loop over nucleons: 1) count number of nucleon-nucleon collisions  2) set status flag for participants 3) sum up overlapping collision area
+		//loop over nucleon pairs: 1) count number of nucleon-nucleon collisions  2) count collisions per nucleon 3) sum up overlapping collision area
 		//collision takes place in z-direction (collisions are in x-y plane with nuclei flattened along z-direction)
-		int n_col = 0; int n_par = 0; double area = 0.; int coll_dist = 1.;
-		for(int inuc_a=0; inuc_a<a_npro_+a_nneu_; inuc_a++){
-			for(int inuc_b=0; inuc_b<b_npro_+b_nneu_; inuc_b++){
-				double dist2 = (nuc_a[inuc_a].x() - nuc_a[inuc_b].x() - offset_x)*(nuc_a[inuc_a].x() - nuc_a[inuc_b].x() - offset_x) +
-				  (nuc_a[inuc_a].y() - nuc_a[inuc_b].y() - offset_y)*(nuc_a[inuc_a].y() - nuc_a[inuc_b].y() - offset_y);
-				if(dist2<=coll_dist*coll_dist){
-					++n_col; nuc_a[inuc_a].stat(1); nuc_a[inuc_b].stat(1);
-					double dist = sqrt(dist2);
-					area += 0.5*dist*sqrt(4.*coll_dist*coll_dist - dist*dist); //assuming nucleons are all the same size
+		//the heavy nucleus is always scanned in the inner loop, so p+A and d+A are a scan over A for each of the 1 or 2 light nucleons
+		int n_col = 0; double area = 0.;
+		//the probabilistic profiles have their own pair loop
+		//with a pool, the pass of two heavy nuclei is split into chunks of outer nucleons; with a probabilistic profile all chunks share the
+		//key of the pass, and each draw is keyed to the pair's nucleon indices in the whole nucleus, so the chunks make the unsplit draws
+		if(A_INNER){
+			const T* xo = p.bx.data(); const T* yo = p.by.data(); T ox = T(-offset_x); T oy = T(-offset_y); T sx = T(0.); T sy = T(0.);
+			if(profile_ == 0){n_col = pairs<T,NB,NA,W,O>(xo, yo, b_hits_.data(), n_b, xi, yi, hits_i, n_a, ox, oy, sx, sy, area, coll_x_, coll_y_);}
+			else if(profile_ == 1){n_col = pairs_prob<T,1,W,O>(xo, yo, b_hits_.data(), n_b, 0, xi, yi, hits_i, n_a, draw_key(), cand_.data(), prob_hit_.data(),
+			  ox, oy, sx, sy, area, coll_x_, coll_y_);}
+			else{n_col = pairs_prob<T,2,W,O>(xo, yo, b_hits_.data(), n_b, 0, xi, yi, hits_i, n_a, draw_key(), cand_.data(), prob_hit_.data(),
+			  ox, oy, sx, sy, area, coll_x_, coll_y_);}
+		}
+		else{
+			const T* xo = p.ax.data(); const T* yo = p.ay.data(); T ox = T(offset_x); T oy = T(offset_y); T sx = T(offset_x); T sy = T(offset_y);
+			if((NA == 0) && (NB == 0) && (n_chunks(n_a) > 1)){
+				int* hits_o = a_hits_.data(); int n_col_hs = 0; const unsigned long long key = (profile_ > 0) ? draw_key() : 0ULL;
+				n_col = split(n_a, n_b, 0, [&](int lo, int hi, Part& part, Chunk& chunk){
+					if(profile_ == 0){
+						return pairs<T,0,0,W,O>(xo + lo, yo + lo, hits_o + lo, hi - lo, xi, yi, part.hits.data(), n_b, ox, oy, sx, sy, chunk.area, chunk.mx, chunk.my);
+					}
+					else if(profile_ == 1){
+						return pairs_prob<T,1,W,O>(xo + lo, yo + lo, hits_o + lo, hi - lo, lo, xi, yi, part.hits.data(), n_b, key, part.cand.data(), part.hit.data(),
+						  ox, oy, sx, sy, chunk.area, chunk.mx, chunk.my);
+					}
+					return pairs_prob<T,2,W,O>(xo + lo, yo + lo, hits_o + lo, hi - lo, lo, xi, yi, part.hits.data(), n_b, key, part.cand.data(), part.hit.data(),
+					  ox, oy, sx, sy, chunk.area, chunk.mx, chunk.my);
+				}, hits_i, nullptr, area, n_col_hs);
+			}
+			else if(profile_ == 0){n_col = pairs<T,NA,NB,W,O>(xo, yo, a_hits_.data(), n_a, xi, yi, hits_i, n_b, ox, oy, sx, sy, area, coll_x_, coll_y_);}
+			else if(profile_ == 1){n_col = pairs_prob<T,1,W,O>(xo, yo, a_hits_.data(), n_a, 0, xi, yi, hits_i, n_b, draw_key(), cand_.data(), prob_hit_.data(),
+			  ox, oy, sx, sy, area, coll_x_, coll_y_);}
+			else{n_col = pairs_prob<T,2,W,O>(xo, yo, a_hits_.data(), n_a, 0, xi, yi, hits_i, n_b, draw_key(), cand_.data(), prob_hit_.data(),
+			  ox, oy, sx, sy, area, coll_x_, coll_y_);}
+		}
+		//scattering the collision counts of the sorted inner nucleus back to its nucleon order
+		if(W && PART){int* hits = A_INNER ? a_hits_.data() : b_hits_.data(); for(int inuc=0; inuc<n_i; inuc++){hits[p.perm[inuc]] = s_hits_[inuc];}}
+		
+		if(n_col > 0){
+			//participant bitmasks from the collision counts, the participants are then counted with popcount
+			//the status flag of the participating nucleons is set along the way, for anything still reading it from the nuclei
+			//the participant center (and with eccentricities on, the participant positions) are gathered in the same pass
+			//without the participants, none of this is done and n_part stays zero
+			part_cx_ = 0.; part_cy_ = 0.; part_x_.clear(); part_y_.clear(); int n_par = 0;
+			if(PART){
+				n_par = mask(nuc_a, a_hits_.data(), a_part_, n_a, 0., 0.) + mask(nuc_b, b_hits_.data(), b_part_, n_b, offset_x, offset_y);
+				part_cx_ /= n_par; part_cy_ /= n_par;
+			}
+			num_coll_ = n_col; num_part_ = n_par; area_tot_ = area; b_x_ = offset_x; b_y_ = offset_y; good_coll=true;
+			if(ecc_){moments();}
+		}
+	}
+}
+
+//hotspot collision kernel, nucleon pairs culled by their reach and then tested hotspot by hotspot
+template<class T> void Event::collide_hs(Nucleus& nuc_a, Nucleus& nuc_b){
+	const int n_a = a_npro_+a_nneu_; const int n_b = b_npro_+b_nneu_; const int nh = n_hs_;
+	
+	//resetting event - clearing to ensure clean slate for new event
+	reset(); last(nuc_a, nuc_b);
+	
+	//gathering the transverse positions, and sampling the hotspots of this event
+	Coords<T>& p = pos(T());
+	for(int inuc_a=0; inuc_a<n_a; inuc_a++){p.ax[inuc_a] = T(nuc_a[inuc_a].x()); p.ay[inuc_a] = T(nuc_a[inuc_a].y());}
+	for(int inuc_b=0; inuc_b<n_b; inuc_b++){p.bx[inuc_b] = T(nuc_b[inuc_b].x()); p.by[inuc_b] = T(nuc_b[inuc_b].y());}
+	sample_hs(p.hax, p.hay, p.ra, n_a); sample_hs(p.hbx, p.hby, p.rb, n_b);
+	
+	//impact parameter bound as in collide_t, with the largest reach of each nucleus in place of the collision distance
+	double r_max = maxrad(p.ax.data(), p.ay.data(), n_a) + maxrad(p.bx.data(), p.by.data(), n_b) +
+	  double(*std::max_element(p.ra.begin(), p.ra.end())) + double(*std::max_element(p.rb.begin(), p.rb.end()));
+	b_area_ = pi*r_max*r_max;
+	
+	//while loop to allow for resampling of collision geometries until a collision happens
+	bool good_coll = false;
+	while(!good_coll){
+		double r_samp = sqrt(r_max*r_max*ran()); ++trials_;
+		double cos_th, sin_th; rng_.azimuth(cos_th, sin_th);
+		double offset_x = r_samp*cos_th; double offset_y = r_samp*sin_th;
+		
+		//clearing per-nucleon and per-hotspot collision counts and the binary collision list
+		for(int inuc_a=0; inuc_a<n_a; inuc_a++){a_hits_[inuc_a] = 0;} for(int inuc_b=0; inuc_b<n_b; inuc_b++){b_hits_[inuc_b] = 0;}
+		for(int ihs=0; ihs<n_a*nh; ihs++){a_hs_hits_[ihs] = 0;} for(int ihs=0; ihs<n_b*nh; ihs++){b_hs_hits_[ihs] = 0;}
+		coll_x_.clear(); coll_y_.clear();
+		
+		//the pass over the nucleons of a, split into chunks with a pool
+		int n_col = 0; int n_col_hs = 0; double area = 0.;
+		if(n_chunks(n_a) > 1){
+			n_col = split(n_a, n_b, n_b*nh, [&](int lo, int hi, Part& part, Chunk& chunk){
+				return pairs_hs<T>(lo, hi, offset_x, offset_y, part.hits.data(), part.hs_hits.data(), part.cand.data(), chunk.area, chunk.n_col_hs, chunk.mx, chunk.my);
+			}, b_hits_.data(), b_hs_hits_.data(), area, n_col_hs);
+		}
+		else{n_col = pairs_hs<T>(0, n_a, offset_x, offset_y, b_hits_.data(), b_hs_hits_.data(), cand_.data(), area, n_col_hs, coll_x_, coll_y_);}
+		
+		if(n_col > 0){
+			part_cx_ = 0.; part_cy_ = 0.; part_x_.clear(); part_y_.clear();
+			int n_par = mask(nuc_a, a_hits_.data(), a_part_, n_a, 0., 0.) + mask(nuc_b, b_hits_.data(), b_part_, n_b, offset_x, offset_y);
+			part_cx_ /= n_par; part_cy_ /= n_par;
+			int n_par_hs = 0;
+			for(int ihs=0; ihs<n_a*nh; ihs++){n_par_hs += (a_hs_hits_[ihs] > 0);} for(int ihs=0; ihs<n_b*nh; ihs++){n_par_hs += (b_hs_hits_[ihs] > 0);}
+			num_coll_ = n_col; num_part_ = n_par; area_tot_ = area; b_x_ = offset_x; b_y_ = offset_y; good_coll=true;
+			num_coll_hs_ = n_col_hs; num_part_hs_ = n_par_hs;
+			if(ecc_){moments();}
+		}
+	}
+}
+
+//hotspot pair loop over the nucleons lo to hi-1 of a, returns the nucleon pairs that collided
+template<class T> int Event::pairs_hs(int lo, int hi, double offset_x, double offset_y, int* hits_b, int* hs_hits_b, int* cand,
+  double& area, int& n_col_hs, std::vector<double>& mx, std::vector<double>& my){
+	const int n_b = b_npro_+b_nneu_; const int nh = n_hs_; Coords<T>& p = pos(T());
+	const T hd2 = T(hs_dist_*hs_dist_);
+	
+	int n_col = 0;
+	for(int ia=lo; ia<hi; ia++){
+		T x = p.ax[ia] - T(offset_x); T y = p.ay[ia] - T(offset_y); T ra = p.ra[ia];
+		
+		//level 1: nucleons of b within the reach of both nucleons, compressed into the candidate list
+		int n_cand = 0;
+		for(int ib=0; ib<n_b; ib++){
+			T dx = x - p.bx[ib]; T dy = y - p.by[ib]; T reach = ra + p.rb[ib];
+			cand[n_cand] = ib; n_cand += (dx*dx + dy*dy <= reach*reach);
+		}
+		
+		//level 2: the hotspot pairs of each surviving nucleon pair
+		for(int icand=0; icand<n_cand; icand++){
+			int ib = cand[icand]; int hits = 0;
+			const T* hbx = &p.hbx[ib*nh]; const T* hby = &p.hby[ib*nh]; int* hits_hb = &hs_hits_b[ib*nh];
+			for(int ka=0; ka<nh; ka++){
+				T hx = x + p.hax[ia*nh+ka] - p.bx[ib]; T hy = y + p.hay[ia*nh+ka] - p.by[ib];
+				int hits_ka = 0; double area_ka = 0.;
+				#pragma omp simd reduction(+:hits_ka,area_ka)
+				for(int kb=0; kb<nh; kb++){
+					T dist2 = (hx - hbx[kb])*(hx - hbx[kb]) + (hy - hby[kb])*(hy - hby[kb]);
+					int hit = (dist2<=hd2);
+					hits_ka += hit; hits_hb[kb] += hit;
+					area_ka += hit ? T(0.5)*std::sqrt(dist2*(T(4.)*hd2 - dist2)) : T(0.);
 				}
+				a_hs_hits_[ia*nh+ka] += hits_ka; hits += hits_ka; area += area_ka;
 			}
+			if(hits == 0){continue;}
+			++a_hits_[ia]; ++hits_b[ib]; ++n_col; n_col_hs += hits;
+			mx.push_back(0.5*(double(x) + double(p.bx[ib])) + offset_x); my.push_back(0.5*(double(y) + double(p.by[ib])) + offset_y);
+		}
+	}
+	
+return n_col;
+}
+
+//split pass: the chunks of outer nucleons run on the pool, then the private inner counts and the chunk results are added up in chunk order
+//only the outer nucleons of a chunk are written to by it, so the outer counts need no merging
+template<class F> int Event::split(int no, int ni, int nhi, F rows, int* hitsi, int* hs_hitsi, double& area, int& n_col_hs){
+	const int n_chk = n_chunks(no); const int n_w = pool_->size();
+	parts_.resize(n_w); chunks_.resize(n_chk);
+	for(int iw=0; iw<n_w; iw++){parts_[iw].hits.assign(ni, 0); parts_[iw].hs_hits.assign(nhi, 0); parts_[iw].cand.resize(ni); parts_[iw].hit.resize(ni);}
+	
+	pool_->run(n_chk, [&](int ichk, int iw){
+		Chunk& chunk = chunks_[ichk]; chunk.area = 0.; chunk.n_col_hs = 0; chunk.mx.clear(); chunk.my.clear();
+		chunk.n_col = rows(int((long long)ichk*no/n_chk), int((long long)(ichk + 1)*no/n_chk), parts_[iw], chunk);
+	});
+	
+	int n_col = 0;
+	for(int ichk=0; ichk<n_chk; ichk++){
+		const Chunk& chunk = chunks_[ichk];
+		n_col += chunk.n_col; n_col_hs += chunk.n_col_hs; area += chunk.area;
+		coll_x_.insert(coll_x_.end(), chunk.mx.begin(), chunk.mx.end()); coll_y_.insert(coll_y_.end(), chunk.my.begin(), chunk.my.end());
+	}
+	for(int iw=0; iw<n_w; iw++){
+		const int* hits = parts_[iw].hits.data(); const int* hs_hits = parts_[iw].hs_hits.data();
+		#pragma omp simd
+		for(int ii=0; ii<ni; ii++){hitsi[ii] += hits[ii];}
+		#pragma omp simd
+		for(int ih=0; ih<nhi; ih++){hs_hitsi[ih] += hs_hits[ih];}
+	}
+	
+return n_col;
+}
+
+//sampling the hotspot offsets of n nucleons and the reach of each nucleon
+//each offset is a Box-Muller pair: radius width*sqrt(-2 ln u) at a uniform azimuth
+template<class T> void Event::sample_hs(std::vector<T>& hx, std::vector<T>& hy, std::vector<T>& reach, int n){
+	const int nh = n_hs_;
+	for(int inuc=0; inuc<n; inuc++){
+		double r2_max = 0.;
+		for(int k=0; k<nh; k++){
+			double r = hs_width_*std::sqrt(-2.*std::log(1. - ran())); double c, s; rng_.azimuth(c, s);
+			hx[inuc*nh+k] = T(r*c); hy[inuc*nh+k] = T(r*s);
+			double r2 = double(hx[inuc*nh+k])*double(hx[inuc*nh+k]) + double(hy[inuc*nh+k])*double(hy[inuc*nh+k]);
+			if(r2 > r2_max){r2_max = r2;}
+		}
+		//a little wide so rounding in T never culls a colliding pair
+		reach[inuc] = T((std::sqrt(r2_max) + 0.5*hs_dist_)*(1. + 1.e-4));
+	}
+}
+
+//deposit the sources of the event onto a transverse grid centered between the two nuclei
+void Event::deposit(Grid& grid, int mode){
+	//nucleus a is centered at the origin and b at the impact parameter offset, shifting both by half of it
+	double sx = 0.5*b_x_; double sy = 0.5*b_y_;
+	if(mode == 2){
+		for(int k=0; k<num_coll_; ++k){grid.deposit(coll_x_[k] - sx, coll_y_[k] - sy);}
+		return;
+	}
+	
+	//walking the set bits of the participant bitmasks
+	for(int iword=0; iword<a_part_.size(); ++iword){
+		for(unsigned long long bits=a_part_[iword]; bits!=0ULL; bits&=bits-1ULL){
+			int inuc = 64*iword + __builtin_ctzll(bits); grid.deposit(last_a()[inuc].x() - sx, last_a()[inuc].y() - sy);
+		}
+	}
+	for(int iword=0; iword<b_part_.size(); ++iword){
+		for(unsigned long long bits=b_part_[iword]; bits!=0ULL; bits&=bits-1ULL){
+			int inuc = 64*iword + __builtin_ctzll(bits); grid.deposit(last_b()[inuc].x() + sx, last_b()[inuc].y() + sy);
+		}
+	}
+}
+
+//setting the participant bitmask and status flags of a nucleus from its per-nucleon collision counts, returns the number of participants
+//the participant positions (shifted by shift_x, shift_y) are added to the participant center sums, and listed if eccentricities are on
+int Event::mask(Nucleus& nuc, const int* hits, std::vector<unsigned long long>& part, int n, double shift_x, double shift_y){
+	for(int iword=0; iword<part.size(); iword++){part[iword] = 0ULL;}
+	for(int inuc=0; inuc<n; inuc++){
+		unsigned long long hit = (hits[inuc] > 0);
+		part[inuc >> 6] |= hit << (inuc & 63);
+		nuc[inuc].stat(int(hit));
+		if(hit){
+			double x = nuc[inuc].x() + shift_x; double y = nuc[inuc].y() + shift_y;
+			part_cx_ += x; part_cy_ += y;
+			if(ecc_){part_x_.push_back(x); part_y_.push_back(y);}
+		}
+	}
+	
+	int n_par = 0;
+	for(int iword=0; iword<part.size(); iword++){n_par += __builtin_popcountll(part[iword]);}
+	
+return n_par;
+}
+
+//eccentricities and participant plane angles of orders 2 to 6, about the participant center
+//eps_n = |sum r^n e^(i n phi)| / sum r^n, psi_n = (atan2(sum r^n sin(n phi), sum r^n cos(n phi)) + pi)/n
+//all orders come from one fused, vectorized pass over the participants using repeated complex multiplication for r^n e^(i n phi)
+void Event::moments(){
+	double re2 = 0., im2 = 0., rn2 = 0., re3 = 0., im3 = 0., rn3 = 0., re4 = 0., im4 = 0., rn4 = 0.;
+	double re5 = 0., im5 = 0., rn5 = 0., re6 = 0., im6 = 0., rn6 = 0.;
+	const double* px = part_x_.data(); const double* py = part_y_.data(); int n_par = part_x_.size();
+	double cx = part_cx_; double cy = part_cy_;
+	#pragma omp simd reduction(+:re2,im2,rn2,re3,im3,rn3,re4,im4,rn4,re5,im5,rn5,re6,im6,rn6)
+	for(int ipar=0; ipar<n_par; ipar++){
+		double x = px[ipar] - cx; double y = py[ipar] - cy;
+		double r2 = x*x + y*y; double r = std::sqrt(r2);
+		//z^n = (x + iy)^n
+		double zr2 = x*x - y*y,     zi2 = 2.*x*y;
+		double zr3 = zr2*x - zi2*y, zi3 = zr2*y + zi2*x;
+		double zr4 = zr2*zr2 - zi2*zi2, zi4 = 2.*zr2*zi2;
+		double zr5 = zr4*x - zi4*y, zi5 = zr4*y + zi4*x;
+		double zr6 = zr3*zr3 - zi3*zi3, zi6 = 2.*zr3*zi3;
+		re2 += zr2; im2 += zi2; rn2 += r2;
+		re3 += zr3; im3 += zi3; rn3 += r2*r;
+		re4 += zr4; im4 += zi4; rn4 += r2*r2;
+		re5 += zr5; im5 += zi5; rn5 += r2*r2*r;
+		re6 += zr6; im6 += zi6; rn6 += r2*r2*r2;
+	}
+	
+	double re[5] = {re2, re3, re4, re5, re6}; double im[5] = {im2, im3, im4, im5, im6}; double rn[5] = {rn2, rn3, rn4, rn5, rn6};
+	for(int n=2; n<=6; n++){
+		ecc_n_[n] = (rn[n-2] > 0.) ? std::sqrt(re[n-2]*re[n-2] + im[n-2]*im[n-2])/rn[n-2] : 0.;
+		psi_n_[n] = (std::atan2(im[n-2], re[n-2]) + pi)/n;
+	}
+}
+
+//pair loop of the collision kernel, returns the number of colliding pairs and adds their overlap area to area
+//the outer nucleus has NO nucleons and the inner NI (0 = not fixed, the runtime counts no/ni are used instead)
+//the collision counts of each nucleon are added to hitso/hitsi, and the midpoint of each colliding pair, shifted by (shift_x, shift_y), is added to mx, my
+//each of these is only done if its observable is in O; with n_coll alone, the inner loop is just the distance test and a count
+template<class T, int NO, int NI, bool W, int O> int Event::pairs(const T* xo, const T* yo, int* hitso, int no, const T* xi, const T* yi, int* hitsi, int ni,
+  T offset_x, T offset_y, T shift_x, T shift_y, double& area, std::vector<double>& mx, std::vector<double>& my){
+	if(NO > 0){no = NO;} if(NI > 0){ni = NI;}
+	const bool PART = (O & OBS_NPART) != 0; const bool AREA = (O & OBS_AREA) != 0; const bool MIDS = (O & OBS_MIDPOINTS) != 0;
+	const T cd2 = T(coll_dist_*coll_dist_);
+	const T cd_w = T(coll_dist_*(1. + 1.e-4)); //window half width, a little wide so rounding never drops a pair from the window
+	
+	int n_col = 0;
+	for(int io=0; io<no; io++){
+		T x = xo[io] - offset_x; T y = yo[io] - offset_y;
+		int lo = 0; int hi = ni;
+		if(W){lo = std::lower_bound(xi, xi + ni, x - cd_w) - xi; hi = std::upper_bound(xi + lo, xi + ni, x + cd_w) - xi;}
+		int hits = 0; double area_o = 0.;
+		#pragma omp simd reduction(+:hits,area_o)
+		for(int ii=lo; ii<hi; ii++){
+			T dist2 = (x - xi[ii])*(x - xi[ii]) + (y - yi[ii])*(y - yi[ii]);
+			int hit = (dist2<=cd2);
+			hits += hit; if(PART){hitsi[ii] += hit;}
+			//0.5*dist*sqrt(4*coll_dist^2 - dist^2) with a single sqrt, assuming nucleons are all the same size
+			if(AREA){area_o += hit ? T(0.5)*std::sqrt(dist2*(T(4.)*cd2 - dist2)) : T(0.);}
 		}
+		if(hits == 0){continue;}
+		if(PART){hitso[io] = hits;} n_col += hits; area += area_o;
 		
-		//second loop, loop over each nucleus and count number of collision participants
-		for(int inuc_a=0; inuc_a<a_npro_+a_nneu_; inuc_a++){if(nuc_a[inuc_a].stat() == 1){++n_par;}}
-		for(int inuc_b=0; inuc_b<b_npro_+b_nneu_; inuc_b++){if(nuc_b[inuc_b].stat() == 1){++n_par;}}
+		//listing the binary collision midpoints of this nucleon; the scan stops once all of its collisions are found
+		if(!MIDS){continue;}
+		for(int ii=lo, found=0; (found<hits) && (ii<hi); ii++){
+			T dist2 = (x - xi[ii])*(x - xi[ii]) + (y - yi[ii])*(y - yi[ii]);
+			if(dist2<=cd2){mx.push_back(0.5*(double(x) + double(xi[ii])) + shift_x); my.push_back(0.5*(double(y) + double(yi[ii])) + shift_y); ++found;}
+		}
+	}
+	
+return n_col;
+}
+
+//exp(-x) for 0 <= x <= 16.2 (the Gaussian profile cutoff, ln(1/prof_eps_)) as plain arithmetic, so it vectorizes without a vector math library
+//exp(-x/32) from its Taylor series to order 11, then squared five times; the relative error in double stays below 1e-10
+template<class T> static inline T exp_neg(T x){
+	T y = x*T(1./32.);
+	T e = T(1.) - y*(T(1.) - y*(T(1./2.) - y*(T(1./6.) - y*(T(1./24.) - y*(T(1./120.) - y*(T(1./720.) - y*(T(1./5040.) - y*(T(1./40320.) -
+	  y*(T(1./362880.) - y*(T(1./3628800.) - y*T(1./39916800.)))))))))));
+	e *= e; e *= e; e *= e; e *= e; e *= e;
+	
+return e;
+}
+
+//uniform double in [0,1) keyed to (key, n): the splitmix64 output for the n'th step from key, so a draw depends only on its key and index
+static inline double keyed_uniform(unsigned long long key, unsigned long long n){
+	unsigned long long z = key + (n + 1ULL)*0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL; z = (z ^ (z >> 27))*0x94D049BB133111EBULL; z ^= z >> 31;
+	
+return double(z >> 11)*(1./9007199254740992.);
+}
+
+//pair loop of the probabilistic profiles, returns the number of colliding pairs and adds their overlap area to area
+//the draw of each pair is keyed to the key of the pass and to the pair's outer (io0 + io) and (unsorted) inner nucleon index, so the outcomes
+//are the same whichever order the kernel finds the candidates in, the sorted and all pairs kernels give the same events, and so do split chunks
+template<class T, int P, bool W, int O> int Event::pairs_prob(const T* xo, const T* yo, int* hitso, int no, int io0, const T* xi, const T* yi, int* hitsi,
+  int ni, unsigned long long key, int* cand, int* hit_c, T offset_x, T offset_y, T shift_x, T shift_y, double& area, std::vector<double>& mx,
+  std::vector<double>& my){
+	const bool PART = (O & OBS_NPART) != 0; const bool AREA = (O & OBS_AREA) != 0; const bool MIDS = (O & OBS_MIDPOINTS) != 0;
+	const T cd2 = T(coll_dist_*coll_dist_); const T rc2 = T(r_cut_*r_cut_); const T amp = T(prof_amp_); const T k = T(prof_k_);
+	const T cd_w = T(r_cut_*(1. + 1.e-4)); //window half width, a little wide so rounding never drops a pair from the window
+	const int* perm = pos(T()).perm.data(); //nucleon index of each sorted inner entry (W only)
+	
+	int n_col = 0;
+	for(int io=0; io<no; io++){
+		T x = xo[io] - offset_x; T y = yo[io] - offset_y;
+		int lo = 0; int hi = ni;
+		if(W){lo = std::lower_bound(xi, xi + ni, x - cd_w) - xi; hi = std::upper_bound(xi + lo, xi + ni, x + cd_w) - xi;}
+		
+		//candidates: the pairs within the cutoff distance, everything further away is rejected before any probability or draw
+		int n_cand = 0;
+		for(int ii=lo; ii<hi; ii++){
+			T dist2 = (x - xi[ii])*(x - xi[ii]) + (y - yi[ii])*(y - yi[ii]);
+			cand[n_cand] = ii; n_cand += (dist2<=rc2);
+		}
+		if(n_cand == 0){continue;}
 		
-		if(n_col > 0){num_coll_ = n_col; num_part_ = n_par; area_tot_ = area; good_coll=true;}
+		//a Bernoulli draw for each candidate against its collision probability
+		int hits = 0; double area_o = 0.;
+		#pragma omp simd reduction(+:hits,area_o)
+		for(int ic=0; ic<n_cand; ic++){
+			int ii = cand[ic]; int id = W ? perm[ii] : ii;
+			T dist2 = (x - xi[ii])*(x - xi[ii]) + (y - yi[ii])*(y - yi[ii]);
+			T prob = (P == 1) ? amp : amp*exp_neg(k*dist2);
+			int hit = (T(keyed_uniform(key, (unsigned long long)(io0 + io)*ni + id)) < prob);
+			hit_c[ic] = hit; hits += hit;
+			//the black disk overlap area formula, zero past twice the collision distance
+			if(AREA){T a2 = dist2*(T(4.)*cd2 - dist2); area_o += (hit && a2 > T(0.)) ? T(0.5)*std::sqrt(a2) : T(0.);}
+		}
+		if(hits == 0){continue;}
+		if(PART){hitso[io] = hits;} n_col += hits; area += area_o;
+		
+		//collision counts of the inner nucleons and the binary collision midpoints
+		if(!PART && !MIDS){continue;}
+		for(int ic=0; ic<n_cand; ic++){
+			if(!hit_c[ic]){continue;}
+			int ii = cand[ic]; if(PART){++hitsi[ii];}
+			if(MIDS){mx.push_back(0.5*(double(x) + double(xi[ii])) + shift_x); my.push_back(0.5*(double(y) + double(yi[ii])) + shift_y);}
+		}
 	}
+	
+return n_col;
 }
 
-//find the max distance between any nucleon in one nucleus and any nucleon in another nucleus in x-y
-double Event::maxdist(Nucleus nuc_a, Nucleus nuc_b){
+//sort the inner nucleus positions in x, keeping the nucleon index of each sorted entry
+template<class T> void Event::sort_inner(Coords<T>& p, const T* x, const T* y, int n){
+	p.perm.resize(n); p.sx.resize(n); p.sy.resize(n);
+	for(int inuc=0; inuc<n; inuc++){p.perm[inuc] = inuc;}
+	std::sort(p.perm.begin(), p.perm.end(), [x](int i, int j){return x[i] < x[j];});
+	for(int inuc=0; inuc<n; inuc++){p.sx[inuc] = x[p.perm[inuc]]; p.sy[inuc] = y[p.perm[inuc]];}
+}
+
+//find the max distance of any nucleon from the center of a nucleus in x-y
+template<class T> double Event::maxrad(const T* x, const T* y, int n){
 	double dist_out = 0.;
-	for(int inuc_a=0; inuc_a<a_npro_+a_nneu_; inuc_a++){
-		for(int inuc_b=0; inuc_b<b_npro_+b_nneu_; inuc_b++){
-			double dist = (nuc_a[inuc_a].x() - nuc_b[inuc_b].x())*(nuc_a[inuc_a].x() - nuc_b[inuc_b].x()) +
-			  (nuc_a[inuc_a].y() - nuc_b[inuc_b].y())*(nuc_a[inuc_a].y() - nuc_b[inuc_b].y());
-			if(dist>dist_out){dist_out = dist;}
-		}
+	for(int inuc=0; inuc<n; inuc++){
+		double dist = double(x[inuc])*double(x[inuc]) + double(y[inuc])*double(y[inuc]);
+		if(dist>dist_out){dist_out = dist;}
 	}
 	
 return std::sqrt(dist_out);
-}
\ No newline at end of file
+}
@@ -0,0 +1,115 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Generator.cpp
+*
+* Description: Embeddable event generator, runs the events of a configuration and hands each one to the caller in-process
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include "Generator.h"
+#include "Tuner.h"
+
+//the reason a configuration cannot be generated, or "" if it can
+std::string Generator::check(const Settings& settings){
+	const int types[2] = {settings.nuctypea, settings.nuctypeb}; const int npro[2] = {settings.num_pro_a, settings.num_pro_b};
+	const int nneu[2] = {settings.num_neu_a, settings.num_neu_b};
+	for(int inuc=0; inuc<2; ++inuc){
+		if((types[inuc] < 0) || (types[inuc] > 2) || (npro[inuc] < 0) || (nneu[inuc] < 0)){return "Nucleus was initialized with bad settings, please check given values.";}
+		if((types[inuc] == 0) && (npro[inuc] + nneu[inuc] != 1)){return "A single nucleon nucleus was initialized with something other than a single nucleon.";}
+		if((types[inuc] == 1) && ((npro[inuc] != 1) || (nneu[inuc] != 1))){return "A deuteron was initialized with something other than a proton & neutron.";}
+		if((types[inuc] == 2) && (npro[inuc] + nneu[inuc] < 3)){return "A heavy nucleus was initialized with too few nucleons.";}
+	}
+	if((settings.shard_n < 1) || (settings.shard_i < 0) || (settings.shard_i >= settings.shard_n)){return "The shard must be given as i/N with 0 <= i < N.";}
+	if((settings.profile < 0) || (settings.profile > 2) || (settings.prof_amp <= 0.) || (settings.prof_amp > 1.)){
+		return "The collision profile must be 0, 1, or 2, with an amplitude in (0,1].";
+	}
+	
+return "";
+}
+
+//sets up the event, kernel choice and seeding for the configuration
+Generator::Generator(const Settings& settings) : settings_(settings),
+  event_(settings.nuctypea, settings.num_pro_a, settings.num_neu_a, settings.nuctypeb, settings.num_pro_b, settings.num_neu_b, settings.coll_dist) {
+	event_.single(settings_.single_prec); event_.ecc(settings_.ecc); event_.hotspots(settings_.hotspots, settings_.hs_dist, settings_.hs_width);
+	event_.profile(settings_.profile, settings_.prof_amp); event_.observables(settings_.needed_observables());
+	
+	//picking the collision kernel and hard-core checks (as set, from the tune file, or benchmarked on a few warm-up events)
+	Tuner tuner(settings_); tuner.apply(event_); tuning_ = tuner.describe();
+	
+	//seeding for a reproducible run; every shard uses the same seed (1 if none is given) with its own disjoint stream
+	if((settings_.seed != 0) || (settings_.shard_n > 1)){event_.seed((settings_.seed != 0) ? settings_.seed : 1, settings_.shard_i);}
+	
+	//a shard makes its share of the events (the first NumE%N shards make one extra)
+	n_eve_ = settings_.n_eve/settings_.shard_n + ((settings_.shard_i < settings_.n_eve%settings_.shard_n) ? 1 : 0);
+	i_eve_ = 0; done_ = (n_eve_ <= 0);
+	n_diff_coll_ = 0; n_diff_part_ = 0; max_diff_area_ = 0.; sum_diff_area_ = 0.; target_err_ = -1.;
+}
+
+//keep histograms of every generated event with these bin ends
+void Generator::histogram(std::vector<double> bins_n, std::vector<double> bins_a){
+	stats_.reset(new Stats(bins_n, bins_a, settings_.ecc, settings_.hotspots, settings_.needed_observables()));
+	if(settings_.cent_obs >= 0){stats_->centrality(settings_.cent_obs, settings_.cent_classes, settings_.cent_k);}
+}
+
+//generate the next event, returns false once the run is over
+bool Generator::next(){
+	if(done_){return false;}
+	
+	if(settings_.validate){
+		//generating a single event in both precisions from the same random streams, comparing the observables
+		int n_coll_other = 0; int n_part_other = 0; double area_other = 0.;
+		event_.gen_check(n_coll_other, n_part_other, area_other);
+		if(n_coll_other != event_.n_coll()){++n_diff_coll_;} if(n_part_other != event_.n_part()){++n_diff_part_;}
+		double diff_area = std::abs(area_other - event_.area())/std::max(event_.area(), 1.e-300);
+		sum_diff_area_ += diff_area; if(diff_area > max_diff_area_){max_diff_area_ = diff_area;}
+	}
+	else{event_.gen();}
+	if(stats_){stats_->fill(event_);}
+	++i_eve_;
+	
+	//adaptive stopping: the precision of the target histogram is checked every n_check_ events, NumE is then the maximum number of events
+	if(i_eve_ >= n_eve_){done_ = true;}
+	else if((settings_.target > 0.) && (i_eve_%n_check_ == 0) && (check_target() >= 0.) && target_reached()){n_eve_ = i_eve_; done_ = true;}
+	
+return true;
+}
+
+//generate the remaining events, calling callback on each
+int Generator::run(const std::function<bool(Event&)>& callback){
+	int n_run = 0;
+	while(next()){
+		++n_run;
+		if(!callback(event_)){break;}
+	}
+	
+return n_run;
+}
+
+//recomputes the relative error in the target range now
+double Generator::check_target(){
+	if(stats_){target_err_ = stats_->rel_err(settings_.target_obs, settings_.target_mean, settings_.target_lo, settings_.target_hi);}
+	
+return target_err_;
+}
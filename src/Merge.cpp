@@ -0,0 +1,70 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Merge.cpp
+*
+* Description: Merges the histogram states written by separate (sharded) runs into a single output
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Stats.h"
+#include "Settings.h"
+
+int main(int argc, char* argv[]){
+	//reading command line arguments: the switches first, then the state files to merge
+	std::string outfile = "output/output.dat"; std::string statefile = ""; std::vector<std::string> infiles;
+	for(int i=1; i<argc; ++i){
+		std::string argument = argv[i];
+		if((argument == "-outfile") && (i+1 < argc)){outfile = argv[++i];}
+		else if((argument == "-statefile") && (i+1 < argc)){statefile = argv[++i];}
+		else if(!argument.empty() && (argument[0] == '-')){infiles.clear(); break;}
+		else{infiles.push_back(argument);}
+	}
+	if(infiles.empty()){
+		std::cout << " Usage: ./Merge.out [-outfile <file>] [-statefile <file>] <state file> [<state file> ...]\n";
+		std::cout << " Merges the histogram state files written by Collider.out (eg. one per -shard) and writes the histograms of all their events.\n";
+		std::cout << " Switch: '-outfile' to change the name of the file the merged histograms are written to. Default: 'output/output.dat'\n";
+		std::cout << " Switch: '-statefile' to also write the merged binary state to the given file, so it can be merged again. Default: '' (none)\n\n";
+		return 0;
+	}
+	
+	//merging every state into the first one, all must have the same histograms and binning
+	Stats stats = Stats::read_state(infiles[0]);
+	for(int ifile=1; ifile<infiles.size(); ++ifile){
+		Stats other = Stats::read_state(infiles[ifile]);
+		if(!stats.same_bins(other)){
+			std::cout << "\n\nThe state file " << infiles[ifile] << " has different histograms or binning than " << infiles[0] << ".\n\n";
+			exit(EXIT_FAILURE);
+		}
+		stats.merge(other);
+	}
+	
+	//writing the merged histograms
+	std::cout << "Merged " << infiles.size() << " state files with " << stats.n_eve() << " events in total.\n";
+	std::cout << "Output written to file: " << outfile << "\n";
+	stats.write(outfile);
+	if(!statefile.empty()){stats.write_state(statefile);}
+	
+return 0;
+}
@@ -0,0 +1,185 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: NucleonFile.cpp
+*
+* Description: Compact binary per-event nucleon output (fixed-point positions, isospin and participant status), with an asynchronous writer and a memory-mapped reader
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <iostream>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "NucleonFile.h"
+
+//nucleon files start and end with these tags
+static const char nucl_tag[8] = {'G','L','N','U','C','L','0','1'};
+static const char nucl_end[8] = {'G','L','N','U','C','E','N','D'};
+
+//opens the file and writes the header
+NucleonWriter::NucleonWriter(const std::string& filename, double res, bool delta, int n_a, int n_b) :
+  out_(filename.c_str(), std::ios::binary), filename_(filename), res_(res), delta_(delta), n_a_(n_a), n_b_(n_b), pending_(false), stop_(false), failed_(false) {
+	if(!out_.is_open()){std::cout << "\n\nThe nucleon file " << filename << " could not be opened.\n\n"; exit(EXIT_FAILURE);}
+	if(res_ <= 0.){std::cout << "\n\nThe nucleon file resolution must be positive.\n\n"; exit(EXIT_FAILURE);}
+	
+	int delta_in = delta_;
+	fill_.reserve(buffer_size_ + 4096); flush_.reserve(buffer_size_ + 4096);
+	fill_.append(nucl_tag, sizeof(nucl_tag)); fill_.append((const char*)&res_, sizeof(res_)); fill_.append((const char*)&delta_in, sizeof(delta_in));
+	fill_.append((const char*)&n_a_, sizeof(n_a_)); fill_.append((const char*)&n_b_, sizeof(n_b_));
+	pos_ = fill_.size();
+	
+	int n_max = std::max(n_a_, n_b_); qx_.resize(n_max); qy_.resize(n_max); qz_.resize(n_max); order_.resize(n_max);
+	writer_ = std::thread(&NucleonWriter::work, this);
+}
+
+//finishes writing, the index is written last
+NucleonWriter::~NucleonWriter(){
+	unsigned long long n_eve = index_.size(); unsigned long long index_pos = pos_;
+	fill_.append((const char*)index_.data(), sizeof(unsigned long long)*index_.size());
+	fill_.append((const char*)&n_eve, sizeof(n_eve)); fill_.append((const char*)&index_pos, sizeof(index_pos)); fill_.append(nucl_end, sizeof(nucl_end));
+	hand_over();
+	{std::lock_guard<std::mutex> guard(lock_); stop_ = true;}
+	wake_.notify_all(); writer_.join();
+	out_.close(); if(!out_){failed_ = true;}
+	check();
+}
+
+//stop the run if a write failed; the file is then incomplete and has no index
+void NucleonWriter::check(){
+	if(failed_){std::cout << "\n\nWriting the nucleon file " << filename_ << " failed.\n\n"; exit(EXIT_FAILURE);}
+}
+
+//encode the nucleons of the last event
+void NucleonWriter::write(Event& event){
+	index_.push_back(pos_);
+	std::size_t start = fill_.size();
+	double b_x = event.b_x(); double b_y = event.b_y(); int n_coll = event.n_coll(); int n_part = event.n_part();
+	fill_.append((const char*)&b_x, sizeof(b_x)); fill_.append((const char*)&b_y, sizeof(b_y));
+	fill_.append((const char*)&n_coll, sizeof(n_coll)); fill_.append((const char*)&n_part, sizeof(n_part));
+	put_nucleus(event.nuc_a(), n_a_); put_nucleus(event.nuc_b(), n_b_);
+	pos_ += fill_.size() - start;
+	if(fill_.size() >= buffer_size_){hand_over();}
+}
+
+//zigzag varint: the sign goes to bit 0 so small negative values stay small, then 7 bits per byte with the high bit set on all but the last
+void NucleonWriter::put_varint(long long val){
+	unsigned long long zz = ((unsigned long long)val << 1) ^ (unsigned long long)(val >> 63);
+	while(zz >= 0x80ULL){fill_.push_back(char((zz & 0x7fULL) | 0x80ULL)); zz >>= 7;}
+	fill_.push_back(char(zz));
+}
+
+//quantize and encode the nucleons of a nucleus
+void NucleonWriter::put_nucleus(Nucleus& nuc, int n){
+	const double inv = 1./res_;
+	for(int inuc=0; inuc<n; inuc++){
+		qx_[inuc] = std::llround(nuc[inuc].x()*inv); qy_[inuc] = std::llround(nuc[inuc].y()*inv); qz_[inuc] = std::llround(nuc[inuc].z()*inv);
+		order_[inuc] = inuc;
+	}
+	if(delta_){std::sort(order_.begin(), order_.begin() + n, [this](int i, int j){return qx_[i] < qx_[j];});}
+	
+	long long x_prev = 0;
+	for(int k=0; k<n; k++){
+		int inuc = order_[k];
+		put_varint(delta_ ? qx_[inuc] - x_prev : qx_[inuc]); x_prev = qx_[inuc];
+		put_varint(qy_[inuc]); put_varint(qz_[inuc]);
+		fill_.push_back(char(((nuc[inuc].id() == 2212) ? 1 : 0) | ((nuc[inuc].stat() != 0) ? 2 : 0)));
+	}
+}
+
+//hand the fill buffer to the writer thread, waiting if it is still writing the previous one
+void NucleonWriter::hand_over(){
+	std::unique_lock<std::mutex> guard(lock_);
+	wake_.wait(guard, [this]{return !pending_;});
+	check();
+	fill_.swap(flush_); fill_.clear(); pending_ = true;
+	guard.unlock(); wake_.notify_all();
+}
+
+//writer thread body, writes each handed over buffer
+void NucleonWriter::work(){
+	std::unique_lock<std::mutex> guard(lock_);
+	while(true){
+		wake_.wait(guard, [this]{return pending_ || stop_;});
+		if(!pending_){break;}
+		guard.unlock();
+		out_.write(flush_.data(), flush_.size()); bool ok = out_.good();
+		guard.lock();
+		if(!ok){failed_ = true;}
+		pending_ = false; wake_.notify_all();
+	}
+}
+
+//maps the file and checks its header and index
+NucleonReader::NucleonReader(const std::string& filename){
+	const std::size_t head_size = sizeof(nucl_tag) + sizeof(double) + 3*sizeof(int); const std::size_t tail_size = 2*sizeof(unsigned long long) + sizeof(nucl_end);
+	int fd = open(filename.c_str(), O_RDONLY); struct stat info;
+	if((fd < 0) || (fstat(fd, &info) != 0) || (info.st_size < (off_t)(head_size + tail_size))){
+		std::cout << "\n\nThe file " << filename << " is missing or is not a nucleon file.\n\n"; exit(EXIT_FAILURE);
+	}
+	map_size_ = info.st_size;
+	void* map = mmap(NULL, map_size_, PROT_READ, MAP_SHARED, fd, 0); close(fd);
+	if(map == MAP_FAILED){std::cout << "\n\nCould not map the nucleon file " << filename << ".\n\n"; exit(EXIT_FAILURE);}
+	map_ = (const char*)map;
+	
+	//header, then the index found through the tail
+	const char* tail = map_ + map_size_ - tail_size; unsigned long long n_eve = 0; unsigned long long index_pos = 0;
+	std::memcpy(&n_eve, tail, sizeof(n_eve)); std::memcpy(&index_pos, tail + sizeof(n_eve), sizeof(index_pos));
+	if((std::memcmp(map_, nucl_tag, sizeof(nucl_tag)) != 0) || (std::memcmp(tail + 2*sizeof(n_eve), nucl_end, sizeof(nucl_end)) != 0) ||
+	  (index_pos + n_eve*sizeof(unsigned long long) + tail_size != map_size_)){
+		std::cout << "\n\nThe file " << filename << " is not a nucleon file, or was not closed.\n\n"; exit(EXIT_FAILURE);
+	}
+	int delta_in = 0; const char* head = map_ + sizeof(nucl_tag);
+	std::memcpy(&res_, head, sizeof(res_)); std::memcpy(&delta_in, head + sizeof(res_), sizeof(int));
+	std::memcpy(&n_a_, head + sizeof(res_) + sizeof(int), sizeof(int)); std::memcpy(&n_b_, head + sizeof(res_) + 2*sizeof(int), sizeof(int));
+	delta_ = (delta_in != 0); index_ = map_ + index_pos; n_eve_ = n_eve;
+}
+
+NucleonReader::~NucleonReader(){munmap((void*)map_, map_size_);}
+
+//decode event i into rec
+void NucleonReader::event(long i, Record& rec) const {
+	unsigned long long offset = 0; std::memcpy(&offset, index_ + i*sizeof(offset), sizeof(offset));
+	const char* p = map_ + offset;
+	std::memcpy(&rec.b_x, p, sizeof(double)); std::memcpy(&rec.b_y, p + sizeof(double), sizeof(double));
+	std::memcpy(&rec.n_coll, p + 2*sizeof(double), sizeof(int)); std::memcpy(&rec.n_part, p + 2*sizeof(double) + sizeof(int), sizeof(int));
+	p += 2*sizeof(double) + 2*sizeof(int);
+	
+	//zigzag varint back to a signed value
+	auto get_varint = [&p]() -> long long {
+		unsigned long long zz = 0; int shift = 0; unsigned char byte;
+		do{byte = (unsigned char)(*p++); zz |= (unsigned long long)(byte & 0x7f) << shift; shift += 7;}while(byte & 0x80);
+		return (long long)(zz >> 1) ^ -(long long)(zz & 1ULL);
+	};
+	std::vector<Nucleon>* nuclei[2] = {&rec.a, &rec.b}; int sizes[2] = {n_a_, n_b_};
+	for(int inuc=0; inuc<2; inuc++){
+		std::vector<Nucleon>& nuc = *nuclei[inuc]; nuc.resize(sizes[inuc]); long long x_prev = 0;
+		for(int k=0; k<sizes[inuc]; k++){
+			long long qx = get_varint(); if(delta_){qx += x_prev;} x_prev = qx;
+			long long qy = get_varint(); long long qz = get_varint(); unsigned char flags = (unsigned char)(*p++);
+			nuc[k].x = qx*res_; nuc[k].y = qy*res_; nuc[k].z = qz*res_; nuc[k].id = (flags & 1) ? 2212 : 2112; nuc[k].stat = (flags >> 1) & 1;
+		}
+	}
+}
@@ -27,15 +27,11 @@
 //includes here
 #include <iostream>
 #include <vector>
-#include <array>
+#include <cmath>
 #include <algorithm>
-#include <functional>
 #include "Nucleus.h"
 #include "Nucleon.h"
 
-//return random double between 0 and 1
-double Nucleus::ran() {std::uniform_real_distribution<double> uniran(0.,1.); return uniran(eng);}
-
 //constructor; type in denotes type of nucleus, n_pro_in is the number of protons in the nucleus, n_neu_in is the same for neutrons
 Nucleus::Nucleus(int type_in, int npro_in, int nneu_in){
 		nuc_type_ = type_in; n_pro_ = npro_in; n_neu_ = nneu_in;
@@ -57,25 +53,21 @@ Nucleus::Nucleus(int type_in, int npro_in, int nneu_in){
 			exit(EXIT_FAILURE);
 		}
 		
-		//seeding the mt19937_64 object (RNG - Mersenne Twist - 64 bit) 'eng' PROPERLY!
-		std::random_device rd;
-		std::array<int,std::mt19937_64::state_size> seedarray; std::generate_n(seedarray.data(), seedarray.size(), std::ref(rd));
-		std::seed_seq seeds(std::begin(seedarray), std::end(seedarray)); eng.seed(seeds);
+		//picking the sampler for this nucleus type, so fill() doesn't need to branch on the type for every event
+		if(     nuc_type_ == 0){sampler_ = &Nucleus::single_nuc;}
+		else if(nuc_type_ == 1){sampler_ = &Nucleus::deuteron;}
+		else{                   sampler_ = &Nucleus::heavy;}
+		hardcore_ = 0; cell_n_ = 0; cell_lo_ = 0.; cell_inv_ = 1.;
 }
 
 //filling the nucleus with nucleons
 //assuming that the number of protons, neutrons, and nucleus type have been set correctly(forced in constructor)
 void Nucleus::fill(){
-	//based on nucleus type, call a different nucleus sampler
-	if(nuc_type_ == 0){
-		single_nuc();
-	}
-	else if(nuc_type_ == 1){
-		deuteron();
-	}
-	else{ //if(nuc_type_ == 2)
-		heavy();
-	}
+	//clearing any previously sampled nucleons, so the same nucleus object can be refilled for every event
+	nucleons_.clear(); nucleons_.reserve(n_pro_ + n_neu_);
+	
+	//calling the nucleus sampler for this nucleus type
+	(this->*sampler_)();
 	
 	//now need to determine which nucleons are protons and which are neutrons
 	int set_pro = 0; int set_neu = 0;
@@ -87,31 +79,31 @@ void Nucleus::fill(){
 }
 
 //create a single nucleon in the nucleus list
-void Nucleus::single_nuc(){nucleons_.push_back(Nucleon());}
+void Nucleus::single_nuc(){nucleons_.push_back(PackedNucleon());}
 
 //create a deuteron - a single proton + single neutron
 void Nucleus::deuteron(){
 	//deuteron parameters - fixed "magic numbers"
-	double Rd = 3.*7.3; //max radius sampled, not a critical parameter for deuteron
-	double ha = 0.228; //Hulthen parameter alpha
-	double hb = 1.18; //Hulthen parameter beta
+	double Rd = deut_rmax; //max radius sampled, not a critical parameter for deuteron
+	double ha = hulthen_a; //Hulthen parameter alpha
+	double hb = hulthen_b; //Hulthen parameter beta
 	double close = 1.; //closest distance nucleons can be in deuteron
 
-	//choosing spacial position
+	//choosing spacial position; the likelihood only depends on the radius, so the direction is only drawn for radii that pass it
 	while (nucleons_.size() < 2){
-		double r = Rd * (pow(ran(),(double)(1./3.))); //sampling a radius uniformly inside of a sphere
-		double th = acos(2.*ran() - 1.); //sampling spherical angle theta
-		double ph = ran()*2.*pi; //sampling spherical angle phi
-		double x_val = r * sin(th) * cos(ph);
-		double y_val = r * sin(th) * sin(ph);
-		double z_val = r * cos(th);
-		double Psi = (pow(r,-2.))*(pow((pow(e,-1.*ha*r)) - (pow(e,-1.*hb*r)),2.)); //sampling Hulthen probability distance
+		double r = Rd * std::cbrt(ran()); //sampling a radius uniformly inside of a sphere
+		double h = std::exp(-ha*r) - std::exp(-hb*r);
+		double Psi = h*h/(r*r); //sampling Hulthen probability distance
 		double k = 0.97*ran(); //sample from 0 - Psi(max)
-		
 		if(Psi < k){continue;} //chosen point fails likelihood check
+		
+		double ux, uy, uz; rng_.direction(ux, uy, uz); //sampling an isotropic direction
+		double x_val = r * ux;
+		double y_val = r * uy;
+		double z_val = r * uz;
 		if((nucleons_.size()>0) && (mindist(x_val, y_val, z_val) < close)){continue;} //chosen point too close to other nucleon
 		
-		nucleons_.push_back(Nucleon(0., x_val, y_val, z_val, 0.935, 0., 0., 0., 0.935, 0, 0));
+		nucleons_.push_back(PackedNucleon(x_val, y_val, z_val));
 	}
 	
 	center();
@@ -120,30 +112,59 @@ void Nucleus::deuteron(){
 //sample positions of nucleons based on Woods-Saxon nucleus
 void Nucleus::heavy(){
 	//Woods-Saxon parameters
-	const double WSR = 1.25*pow(n_pro_ + n_neu_,(1./3.)); //Woods-Saxon parameter R parametrized based number of nucleons
-	const double WSa = 0.535; //Woods-Saxon parameter a
+	const double WSR = ws_radius(n_pro_ + n_neu_); //Woods-Saxon parameter R parametrized based number of nucleons
+	const double WSa = ws_a; //Woods-Saxon parameter a
 	const double RA = 3.*WSR; //max radius sampled, not a critical parameter for deuteron
 	double close = 1.; //closest distance nucleons can be in nucleus
 	
+	//cell grid for the hard-core check, of cells of the hard-core distance over the bulk of the nucleus (WSR + 10 WSa)
+	if(hardcore_ == 1){
+		cell_lo_ = -(WSR + 10.*WSa); cell_inv_ = 1./close; cell_n_ = int(std::ceil(-2.*cell_lo_*cell_inv_));
+		cell_head_.assign(cell_n_*cell_n_*cell_n_, -1); cell_next_.resize(n_pro_ + n_neu_);
+	}
+	
+	//the likelihood only depends on the radius, so the direction is only drawn for radii that pass it
 	while (nucleons_.size() < n_pro_ + n_neu_){
-		double r = (5.00/3.00) * RA * (pow(ran(),(double)(1.0/3.0)));  //sampling a radius uniformly inside of a sphere
-		double th = acos(2.0*ran() - 1.0); //sampling spherical angle theta
-		double ph = ran()*2.0*pi; //sampling spherical angle phi
-		double x_val = r * sin(th) * cos(ph);
-		double y_val = r * sin(th) * sin(ph);
-		double z_val = r * cos(th);
-		double Psi = 1.00/(1.00 + pow(e, (r - WSR)/WSa)); //sampling Woods-Saxon probability distance
+		double r = (5.00/3.00) * RA * std::cbrt(ran());  //sampling a radius uniformly inside of a sphere
+		double Psi = 1.00/(1.00 + std::exp((r - WSR)/WSa)); //sampling Woods-Saxon probability distance
 		double k = ran(); //sample from 0 - Psi(max)
-		
 		if(Psi < k){continue;} //chosen point fails likelihood check
-		if((nucleons_.size()>0) && (mindist(x_val, y_val, z_val) < close)){continue;} //chosen point too close to other nucleon
 		
-		nucleons_.push_back(Nucleon(0., x_val, y_val, z_val, 0.935, 0., 0., 0., 0.935, 0, 0));
+		double ux, uy, uz; rng_.direction(ux, uy, uz); //sampling an isotropic direction
+		double x_val = r * ux;
+		double y_val = r * uy;
+		double z_val = r * uz;
+		if(hardcore_ == 1){
+			if(near_cells(x_val, y_val, z_val, close)){continue;} //chosen point too close to other nucleon
+			int icell = (cell(z_val)*cell_n_ + cell(y_val))*cell_n_ + cell(x_val);
+			cell_next_[nucleons_.size()] = cell_head_[icell]; cell_head_[icell] = nucleons_.size();
+		}
+		else if((nucleons_.size()>0) && (mindist(x_val, y_val, z_val) < close)){continue;} //chosen point too close to other nucleon
+		
+		nucleons_.push_back(PackedNucleon(x_val, y_val, z_val));
 	}
 	
 	center();
 }
 
+//if any placed nucleon is closer than close to x_in,y_in,z_in, checking only the 27 cells around the point
+bool Nucleus::near_cells(double x_in, double y_in, double z_in, double close){
+	int ix = cell(x_in); int iy = cell(y_in); int iz = cell(z_in);
+	for(int jz=std::max(iz-1, 0); jz<=std::min(iz+1, cell_n_-1); jz++){
+		for(int jy=std::max(iy-1, 0); jy<=std::min(iy+1, cell_n_-1); jy++){
+			for(int jx=std::max(ix-1, 0); jx<=std::min(ix+1, cell_n_-1); jx++){
+				for(int inuc=cell_head_[(jz*cell_n_ + jy)*cell_n_ + jx]; inuc>=0; inuc=cell_next_[inuc]){
+					double dist = (x_in - nucleons_[inuc].x())*(x_in - nucleons_[inuc].x()) +
+					  (y_in - nucleons_[inuc].y())*(y_in - nucleons_[inuc].y()) + (z_in - nucleons_[inuc].z())*(z_in - nucleons_[inuc].z());
+					if(std::sqrt(dist) < close){return true;}
+				}
+			}
+		}
+	}
+	
+return false;
+}
+
 //put center of mass of nucleus at x=0,y=0,z=0
 void Nucleus::center(){
 	//initializing CM position
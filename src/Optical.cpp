@@ -0,0 +1,308 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Optical.cpp
+*
+* Description: Optical Glauber model: mean N_coll, N_part and overlap area against impact parameter from tabulated nuclear thickness functions
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <iostream>
+#include <fstream>
+#include <cmath>
+#include <algorithm>
+#include "Optical.h"
+#include "Nucleus.h"
+
+//grid step of every table in fm
+const double Optical::dr_ = 0.05;
+
+//Gauss-Legendre nodes and weights on [0,1], for the azimuthal integral over the reach of the collision profile
+static const int n_gl = 16;
+static void gauss_legendre(double* x, double* w){
+	const double pi = 3.14159265358979;
+	for(int i=0; i<n_gl; ++i){
+		//Newton iteration on P_n from the Chebyshev guess, then mapped from [-1,1] to [0,1]
+		double z = std::cos(pi*(i + 0.75)/(n_gl + 0.5)); double dp = 1.;
+		for(int iter=0; iter<100; ++iter){
+			double p0 = 1.; double p1 = z;
+			for(int n=2; n<=n_gl; ++n){double p2 = ((2.*n - 1.)*z*p1 - (n - 1.)*p0)/n; p0 = p1; p1 = p2;}
+			dp = n_gl*(z*p1 - p0)/(z*z - 1.);
+			double dz = p1/dp; z -= dz;
+			if(std::abs(dz) < 1.e-15){break;}
+		}
+		x[i] = 0.5*(1. - z); w[i] = 1./((1. - z*z)*dp*dp);
+	}
+}
+
+//linear interpolation in the table, zero past its end
+double Optical::Table::at(double r) const {
+	double pos = r/dr; int i = int(pos);
+	if(i >= int(val.size()) - 1){return 0.;}
+	double frac = pos - i;
+	
+return val[i] + frac*(val[i+1] - val[i]);
+}
+
+//tabulates everything for the nuclei and collision profile of the settings
+Optical::Optical(const Settings& settings){
+	if(settings.hotspots > 0){std::cout << "\n\nThe optical Glauber model has no hotspot mode.\n\n"; exit(EXIT_FAILURE);}
+	n_a_ = settings.num_pro_a + settings.num_neu_a; n_b_ = settings.num_pro_b + settings.num_neu_b;
+	
+	//the collision profile, the same as Event::profile
+	coll_dist_ = settings.coll_dist; profile_ = settings.profile; prof_amp_ = (profile_ == 0) ? 1. : settings.prof_amp;
+	if((profile_ < 0) || (profile_ > 2) || (prof_amp_ <= 0.) || (prof_amp_ > 1.)){
+		std::cout << "\n\nThe collision profile must be 0, 1, or 2, with an amplitude in (0,1].\n\n"; exit(EXIT_FAILURE);
+	}
+	prof_k_ = prof_amp_/(coll_dist_*coll_dist_);
+	if(profile_ == 0){r_cut_ = coll_dist_;}
+	else if(profile_ == 1){r_cut_ = coll_dist_/std::sqrt(prof_amp_);}
+	else{r_cut_ = std::sqrt(std::max(std::log(prof_amp_/1.e-7), 0.)/prof_k_);}
+	
+	//thickness functions, and each folded with the collision profile
+	t_a_ = thickness(settings.nuctypea, n_a_); t_b_ = thickness(settings.nuctypeb, n_b_);
+	if(!t_a_.point){g_a_ = fold_profile(t_a_, false);} if(!t_b_.point){g_b_ = fold_profile(t_b_, false);}
+	
+	//N_coll(b) and area(b) per nucleon pair: one thickness function folded with the other's fold with the (area weighted) profile
+	//N_part(b): each nucleon of a takes part unless it misses all n_b nucleons of b, 1 - (1 - g_b)^n_b, folded with t_a, and the same for b
+	//a single nucleon side needs no fold, and two single nucleons are the collision profile itself (see at())
+	if(t_a_.point && t_b_.point){b_max_ = r_cut_; return;}
+	Table h_a; Table h_b;
+	if(t_a_.point){
+		t_ab_ = g_b_; area_ab_ = fold_profile(t_b_, true);
+		h_b = g_b_; for(int i=0; i<h_b.val.size(); ++i){h_b.val[i] = 1. - std::pow(1. - std::min(g_b_.val[i], 1.), n_b_);}
+		part_ab_ = h_b; for(int i=0; i<part_ab_.val.size(); ++i){part_ab_.val[i] += n_b_*g_b_.val[i];}
+	}
+	else if(t_b_.point){
+		t_ab_ = g_a_; area_ab_ = fold_profile(t_a_, true);
+		h_a = g_a_; for(int i=0; i<h_a.val.size(); ++i){h_a.val[i] = 1. - std::pow(1. - std::min(g_a_.val[i], 1.), n_a_);}
+		part_ab_ = h_a; for(int i=0; i<part_ab_.val.size(); ++i){part_ab_.val[i] += n_a_*g_a_.val[i];}
+	}
+	else{
+		t_ab_ = fold(t_a_, g_b_); area_ab_ = fold(t_a_, fold_profile(t_b_, true));
+		h_a = g_a_; for(int i=0; i<h_a.val.size(); ++i){h_a.val[i] = 1. - std::pow(1. - std::min(g_a_.val[i], 1.), n_a_);}
+		h_b = g_b_; for(int i=0; i<h_b.val.size(); ++i){h_b.val[i] = 1. - std::pow(1. - std::min(g_b_.val[i], 1.), n_b_);}
+		Table part_a = fold(t_a_, h_b); Table part_b = fold(t_b_, h_a);
+		part_ab_ = part_a; part_ab_.val.resize(std::max(part_a.val.size(), part_b.val.size()), 0.);
+		for(int i=0; i<part_ab_.val.size(); ++i){part_ab_.val[i] = n_a_*part_ab_.val[i] + n_b_*part_b.at(i*dr_);}
+	}
+	b_max_ = t_ab_.r_max();
+}
+
+//thickness function of a nucleus, normalized to one nucleon
+//heavy: the Woods-Saxon density, cut where it is below 1e-13 of the center (or at the largest sampled radius); deuteron: each nucleon is
+//sampled from the Hulthen density and the pair is then recentered, so a nucleon sits at half the separation of two independent draws
+Optical::Table Optical::thickness(int type, int n_nuc){
+	Table t; t.dr = dr_; t.point = (type == 0);
+	if(type == 0){t.val.assign(1, 0.); return t;}
+	if(type == 2){
+		const double ws_r = Nucleus::ws_radius(n_nuc); const double ws_a = Nucleus::ws_a;
+		return project([ws_r, ws_a](double r){return 1./(1. + std::exp((r - ws_r)/ws_a));}, std::min(5.*ws_r, ws_r + 30.*ws_a));
+	}
+	
+	const double ha = Nucleus::hulthen_a; const double hb = Nucleus::hulthen_b;
+	Table single = project([ha, hb](double r){
+		if(r < 1.e-9){return (hb - ha)*(hb - ha);}
+		double h = std::exp(-ha*r) - std::exp(-hb*r); return h*h/(r*r);
+	}, Nucleus::deut_rmax);
+	Table sep = fold(single, single);
+	int n = int(std::ceil(Nucleus::deut_rmax/dr_)) + 1; t.val.resize(n);
+	double norm = 0.;
+	for(int i=0; i<n; ++i){t.val[i] = sep.at(2.*i*dr_); norm += 2.*3.14159265358979*i*dr_*t.val[i]*dr_;}
+	for(int i=0; i<n; ++i){t.val[i] /= norm;}
+	
+return t;
+}
+
+//integral along z of a radial density out to r_max, normalized so its integral over the plane is one
+//the z integral is the trapezoid rule on a grid of half the table step, vectorized over the table points
+template<class F> Optical::Table Optical::project(F density, double r_max){
+	Table t; t.dr = dr_; t.point = false;
+	int n = int(std::ceil(r_max/dr_)) + 1; t.val.assign(n, 0.);
+	const double dz = 0.5*dr_; const int n_z = int(std::ceil(r_max/dz)) + 1; const double r2_max = r_max*r_max;
+	std::vector<double> rho(n);
+	for(int iz=0; iz<n_z; ++iz){
+		double z = iz*dz; double w = (iz == 0) ? dz : 2.*dz; //both sides of z=0
+		double* val = t.val.data();
+		for(int i=0; i<n; ++i){double r2 = i*dr_*i*dr_ + z*z; rho[i] = (r2 <= r2_max) ? density(std::sqrt(r2)) : 0.;}
+		#pragma omp simd
+		for(int i=0; i<n; ++i){val[i] += w*rho[i];}
+	}
+	t.val.back() = 0.;
+	double norm = 0.;
+	for(int i=0; i<n; ++i){norm += 2.*3.14159265358979*i*dr_*t.val[i]*dr_;}
+	for(int i=0; i<n; ++i){t.val[i] /= norm;}
+	
+return t;
+}
+
+//2D convolution of two radial functions, (f*g)(b) = int d^2u f(|u|) g(|b - u|)
+//the azimuthal integral is the trapezoid rule over a full period (exact up to the interpolation for these smooth periodic integrands),
+//the radial one the trapezoid rule on the table grid; the inner loop over the azimuth is vectorized
+Optical::Table Optical::fold(const Table& f, const Table& g){
+	if(f.point){return g;} if(g.point){return f;}
+	Table out; out.dr = dr_; out.point = false;
+	int n_out = int(std::ceil((f.r_max() + g.r_max())/dr_)) + 1; out.val.assign(n_out, 0.);
+	const double pi = 3.14159265358979; const int n_half = n_phi_/2;
+	double cos_phi[n_half+1]; double w_phi[n_half+1];
+	for(int k=0; k<=n_half; ++k){cos_phi[k] = std::cos(2.*pi*k/n_phi_); w_phi[k] = ((k == 0) || (k == n_half)) ? 1. : 2.;}
+	const double* gv = g.val.data(); const int n_g = g.val.size(); const double inv_dr = 1./dr_;
+	
+	for(int ib=0; ib<n_out; ++ib){
+		double b = ib*dr_; double sum = 0.;
+		for(int iu=1; iu<f.val.size(); ++iu){
+			double u = iu*dr_; double fu = f.val[iu]; if(fu == 0.){continue;}
+			double ring = 0.;
+			#pragma omp simd reduction(+:ring)
+			for(int k=0; k<=n_half; ++k){
+				double pos = std::sqrt(b*b + u*u - 2.*b*u*cos_phi[k])*inv_dr; int i = int(pos); double frac = pos - i;
+				double val = (i < n_g - 1) ? gv[i] + frac*(gv[i+1] - gv[i]) : 0.;
+				ring += w_phi[k]*val;
+			}
+			sum += u*fu*ring;
+		}
+		out.val[ib] = sum*dr_*(2.*pi/n_phi_);
+	}
+	out.val.back() = 0.;
+	
+return out;
+}
+
+//collision probability at a distance, times the black disk overlap area formula of Event if area is set
+double Optical::profile(double dist, bool area) const {
+	if(dist > profile_reach(area)){return 0.;}
+	double prob = (profile_ == 0) ? 1. : (profile_ == 1) ? prof_amp_ : prof_amp_*std::exp(-prof_k_*dist*dist);
+	if(!area){return prob;}
+	double a2 = dist*dist*(4.*coll_dist_*coll_dist_ - dist*dist);
+	
+return (a2 > 0.) ? prob*0.5*std::sqrt(a2) : 0.;
+}
+
+//largest distance the profile (times the overlap area) is nonzero at
+double Optical::profile_reach(bool area) const {return area ? std::min(r_cut_, 2.*coll_dist_) : r_cut_;}
+
+//2D convolution with the collision profile, (f*p)(b) = int d^2u f(|u|) p(|b - u|)
+//p is zero past its reach R, so for each ring of radius u only the arc within R of b is integrated, by Gauss-Legendre over its angle;
+//this is exact for the black and gray disks (p is constant on the arc) and smooth for the Gaussian and the area weighted profiles
+Optical::Table Optical::fold_profile(const Table& f, bool area){
+	Table out; out.dr = dr_; out.point = false;
+	const double reach = profile_reach(area);
+	int n_out = int(std::ceil((f.r_max() + reach)/dr_)) + 1; out.val.assign(n_out, 0.);
+	double x_gl[n_gl]; double w_gl[n_gl]; gauss_legendre(x_gl, w_gl);
+	
+	for(int ib=0; ib<n_out; ++ib){
+		double b = ib*dr_; double sum = 0.;
+		for(int iu=1; iu<f.val.size(); ++iu){
+			double u = iu*dr_; double fu = f.val[iu]; if((fu == 0.) || (std::abs(b - u) > reach)){continue;}
+			//the arc |b - u| <= reach is the azimuth 0 to phi_max on either side
+			double c = (b*b + u*u - reach*reach)/(2.*b*u + 1.e-300);
+			double phi_max = (c <= -1.) ? 3.14159265358979 : std::acos(std::min(c, 1.));
+			double arc = 0.;
+			for(int k=0; k<n_gl; ++k){arc += w_gl[k]*profile(std::sqrt(std::max(b*b + u*u - 2.*b*u*std::cos(phi_max*x_gl[k]), 0.)), area);}
+			sum += u*fu*2.*phi_max*arc;
+		}
+		out.val[ib] = sum*dr_;
+	}
+	out.val.back() = 0.;
+	
+return out;
+}
+
+//the values at impact parameter b
+Optical::Point Optical::at(double b) const {
+	Point pt; pt.b = b;
+	if(t_a_.point && t_b_.point){
+		pt.p_inel = profile(b, false); pt.n_coll = pt.p_inel; pt.n_part = 2.*pt.p_inel; pt.area = profile(b, true);
+		return pt;
+	}
+	double t = std::min(t_ab_.at(b), 1.); double n_pairs = double(n_a_)*double(n_b_);
+	pt.n_coll = n_pairs*t; pt.area = n_pairs*area_ab_.at(b); pt.n_part = part_ab_.at(b);
+	//with a single nucleon on one side, P_inel is exactly the chance it hits any nucleon of the other; otherwise the pairs are taken as independent
+	if(t_a_.point){pt.p_inel = 1. - std::pow(1. - std::min(g_b_.at(b), 1.), n_b_);}
+	else if(t_b_.point){pt.p_inel = 1. - std::pow(1. - std::min(g_a_.at(b), 1.), n_a_);}
+	else{pt.p_inel = 1. - std::pow(1. - t, n_pairs);}
+	
+return pt;
+}
+
+//the values on a grid of impact parameters from 0 to b_max() with step db
+std::vector<Optical::Point> Optical::grid(double db) const {
+	std::vector<Point> out;
+	for(int ib=0; ib*db<=b_max_; ++ib){out.push_back(at(ib*db));}
+	
+return out;
+}
+
+//inelastic cross section, the trapezoid rule over the table grid (the black disk edge of two single nucleons is integrated exactly)
+double Optical::sigma_inel() const {
+	if(t_a_.point && t_b_.point){
+		const double pi = 3.14159265358979;
+		return (profile_ == 2) ? pi*prof_amp_*(1. - std::exp(-prof_k_*r_cut_*r_cut_))/prof_k_ : pi*r_cut_*r_cut_*prof_amp_;
+	}
+	double sigma = 0.;
+	for(int ib=1; ib*dr_<=b_max_; ++ib){sigma += 2.*3.14159265358979*ib*dr_*at(ib*dr_).p_inel*dr_;}
+	
+return sigma;
+}
+
+//minimum bias values, averaged over the impact parameter plane weighted by P_inel for b and by one for the others (their values at b
+//already include the events without a collision)
+Optical::Point Optical::min_bias() const {
+	Point mb; mb.b = 0.; mb.p_inel = 1.; mb.n_coll = 0.; mb.n_part = 0.; mb.area = 0.;
+	const int n_sub = (t_a_.point && t_b_.point) ? 100 : 1; const double db = dr_/n_sub; //two single nucleons have a sharp edge, finer steps there
+	double norm = 0.;
+	for(int ib=1; ib*db<=b_max_ + db; ++ib){
+		Point pt = at(ib*db); double w = 2.*3.14159265358979*ib*db*db;
+		norm += w*pt.p_inel; mb.b += w*pt.p_inel*pt.b; mb.n_coll += w*pt.n_coll; mb.n_part += w*pt.n_part; mb.area += w*pt.area;
+	}
+	if(norm > 0.){mb.b /= norm; mb.n_coll /= norm; mb.n_part /= norm; mb.area /= norm;}
+	
+return mb;
+}
+
+//writing the grid and the minimum bias values to outfile, in the layout of the Monte Carlo output
+void Optical::write(const std::string& outfile, double db) const {
+	std::ofstream fileout(outfile.c_str());
+	std::vector<Point> pts = grid(db);
+	
+	fileout << "\n";
+	fileout << "N_coll vs b:";
+	fileout << "b, N_coll";
+	for(int ib=0; ib<pts.size(); ++ib){fileout << pts[ib].b << ", " << pts[ib].n_coll << "\n";}
+	fileout << "\n\n\n\n\n\n\n\n\n\n";
+	fileout << "N_part vs b:";
+	fileout << "b, N_part";
+	for(int ib=0; ib<pts.size(); ++ib){fileout << pts[ib].b << ", " << pts[ib].n_part << "\n";}
+	fileout << "\n\n\n\n\n\n\n\n\n\n";
+	fileout << "Area vs b:";
+	fileout << "b, Area";
+	for(int ib=0; ib<pts.size(); ++ib){fileout << pts[ib].b << ", " << pts[ib].area << "\n";}
+	fileout << "\n\n\n\n\n\n\n\n\n\n";
+	fileout << "P_inel vs b:";
+	fileout << "b, P_inel";
+	for(int ib=0; ib<pts.size(); ++ib){fileout << pts[ib].b << ", " << pts[ib].p_inel << "\n";}
+	Point mb = min_bias();
+	fileout << "\n\n\n\n\n\n\n\n\n\n";
+	fileout << "Minimum Bias:";
+	fileout << "Sigma_inel (fm^2), AvgB, AvgN_coll, AvgN_part, AvgArea";
+	fileout << sigma_inel() << ", " << mb.b << ", " << mb.n_coll << ", " << mb.n_part << ", " << mb.area << "\n";
+	fileout.close();
+}
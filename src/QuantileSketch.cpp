@@ -0,0 +1,157 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: QuantileSketch.cpp
+*
+* Description: Mergeable streaming quantile sketch (KLL) with bounded memory, giving centrality classes and their mean N_coll and N_part
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <cmath>
+#include <algorithm>
+#include "QuantileSketch.h"
+
+//empty sketch with size parameter k
+QuantileSketch::QuantileSketch(int k){
+	k_ = std::max(k, 8); n_ = 0; coin_ = 0x9e3779b97f4a7c15ULL;
+	levels_.resize(1); levels_[0].reserve(k_);
+}
+
+//reading a sketch back from its binary state; the order is the one written by write_state
+QuantileSketch::QuantileSketch(std::istream& in){
+	int n_levels = 0; int sizes[max_levels_] = {0};
+	k_ = 0; n_ = 0; coin_ = 0;
+	in.read((char*)&k_, sizeof(k_)); in.read((char*)&n_, sizeof(n_)); in.read((char*)&coin_, sizeof(coin_)); in.read((char*)&n_levels, sizeof(n_levels));
+	in.read((char*)sizes, sizeof(sizes));
+	long n_max = 3L*k_ + 3L*max_levels_; long n_items = 0;
+	for(int h=0; h<max_levels_; ++h){n_items += sizes[h];}
+	if(!in || (k_ < 8) || (n_levels < 1) || (n_levels > max_levels_) || (n_items > n_max)){in.setstate(std::ios::failbit); k_ = 8; n_ = 0; levels_.resize(1); return;}
+	
+	//the items of every level, then the padding up to the fixed size
+	std::vector<Item> items(n_max); in.read((char*)items.data(), sizeof(Item)*n_max);
+	levels_.resize(n_levels); long pos = 0;
+	for(int h=0; h<n_levels; ++h){levels_[h].assign(items.begin() + pos, items.begin() + pos + sizes[h]); pos += sizes[h];}
+}
+
+//writing the binary state: k, the count, the coin, the level sizes, and the items padded to the largest size a sketch of this k can have
+void QuantileSketch::write_state(std::ostream& out) const {
+	int n_levels = levels_.size(); int sizes[max_levels_] = {0};
+	for(int h=0; h<n_levels; ++h){sizes[h] = levels_[h].size();}
+	out.write((const char*)&k_, sizeof(k_)); out.write((const char*)&n_, sizeof(n_)); out.write((const char*)&coin_, sizeof(coin_));
+	out.write((const char*)&n_levels, sizeof(n_levels)); out.write((const char*)sizes, sizeof(sizes));
+	long n_max = 3L*k_ + 3L*max_levels_; long n_items = 0;
+	for(int h=0; h<n_levels; ++h){out.write((const char*)levels_[h].data(), sizeof(Item)*levels_[h].size()); n_items += levels_[h].size();}
+	const Item pad = {0., 0., 0.};
+	for(long i=n_items; i<n_max; ++i){out.write((const char*)&pad, sizeof(pad));}
+}
+
+//capacity of level h, k*(2/3)^(levels above it) but at least 2
+int QuantileSketch::capacity(int h) const {
+	int depth = levels_.size() - 1 - h;
+	
+return std::max(2, int(std::ceil(k_*std::pow(2./3., depth))));
+}
+
+//items kept over all levels
+long QuantileSketch::size() const {
+	long n_items = 0;
+	for(int h=0; h<levels_.size(); ++h){n_items += levels_[h].size();}
+	
+return n_items;
+}
+
+//capacity over all levels, at most k/(1-2/3) + 3 per level
+long QuantileSketch::capacity() const {
+	long cap = 0;
+	for(int h=0; h<levels_.size(); ++h){cap += capacity(h);}
+	
+return cap;
+}
+
+//compacting levels until the sketch is within its capacity
+//the lowest level at its capacity is sorted, and every other item from a random start moves up a level with twice the weight; with an odd
+//number of items, the first one stays behind, so the total weight is always the number of values added
+void QuantileSketch::compress(){
+	while(size() >= capacity()){
+		int h = 0;
+		while((h < levels_.size()) && (levels_[h].size() < capacity(h))){++h;}
+		if(h == levels_.size()){break;}
+		if(h + 1 == levels_.size()){
+			if(levels_.size() == max_levels_){break;}
+			levels_.push_back(std::vector<Item>());
+		}
+		
+		std::vector<Item>& level = levels_[h];
+		std::sort(level.begin(), level.end(), [](const Item& a, const Item& b){return a.key < b.key;});
+		coin_ ^= coin_ << 13; coin_ ^= coin_ >> 7; coin_ ^= coin_ << 17;
+		int start = level.size()%2; int offset = int(coin_ & 1ULL);
+		for(int i=start+offset; i<level.size(); i+=2){levels_[h+1].push_back(level[i]);}
+		level.resize(start);
+	}
+}
+
+//adding the values of another sketch into this one
+void QuantileSketch::merge(const QuantileSketch& other){
+	while(levels_.size() < other.levels_.size()){levels_.push_back(std::vector<Item>());}
+	for(int h=0; h<other.levels_.size(); ++h){levels_[h].insert(levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());}
+	n_ += other.n_;
+	compress();
+}
+
+//the value with a fraction q of the values below it
+double QuantileSketch::quantile(double q) const {
+	std::vector<std::pair<double, double> > items;
+	for(int h=0; h<levels_.size(); ++h){for(int i=0; i<levels_[h].size(); ++i){items.push_back(std::make_pair(levels_[h][i].key, std::ldexp(1., h)));}}
+	if(items.empty()){return 0.;}
+	std::sort(items.begin(), items.end());
+	
+	double rank = q*n_; double cum = 0.;
+	for(int i=0; i<items.size(); ++i){cum += items[i].second; if(cum > rank){return items[i].first;}}
+	
+return items.back().first;
+}
+
+//n_classes centrality classes of equal size, from the largest values down
+//each item covers a range of ranks as wide as its weight, and is shared between the classes that range overlaps
+std::vector<QuantileSketch::Class> QuantileSketch::classes(int n_classes) const {
+	std::vector<std::pair<double, const Item*> > items;
+	for(int h=0; h<levels_.size(); ++h){for(int i=0; i<levels_[h].size(); ++i){items.push_back(std::make_pair(std::ldexp(1., h), &levels_[h][i]));}}
+	std::sort(items.begin(), items.end(), [](const std::pair<double, const Item*>& a, const std::pair<double, const Item*>& b){return a.second->key > b.second->key;});
+	
+	std::vector<Class> out(n_classes); std::vector<double> weight(n_classes, 0.);
+	for(int icl=0; icl<n_classes; ++icl){
+		out[icl].pct_lo = 100.*icl/n_classes; out[icl].pct_hi = 100.*(icl + 1)/n_classes;
+		out[icl].key_lo = 0.; out[icl].key_hi = 0.; out[icl].n_coll = 0.; out[icl].n_part = 0.;
+	}
+	double width = double(n_)/n_classes; double cum = 0.;
+	for(int i=0; i<items.size(); ++i){
+		double lo = cum; double hi = cum + items[i].first; cum = hi; const Item& item = *items[i].second;
+		for(int icl=std::max(0, int(lo/width)); (icl < n_classes) && (icl*width < hi); ++icl){
+			double w = std::min(hi, (icl + 1)*width) - std::max(lo, icl*width);
+			if(w <= 0.){continue;}
+			if(weight[icl] == 0.){out[icl].key_hi = item.key;}
+			out[icl].key_lo = item.key; weight[icl] += w; out[icl].n_coll += w*item.n_coll; out[icl].n_part += w*item.n_part;
+		}
+	}
+	for(int icl=0; icl<n_classes; ++icl){if(weight[icl] > 0.){out[icl].n_coll /= weight[icl]; out[icl].n_part /= weight[icl];}}
+	
+return out;
+}
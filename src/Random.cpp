@@ -0,0 +1,144 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Random.cpp
+*
+* Description: Buffered uniform random numbers from a vectorized generator, with batched direction and azimuth helpers
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <random>
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+#include <cmath>
+#include "Random.h"
+
+//seeding all streams from std::random_device, through a seed_seq as done for the old mt19937_64 engines
+Random::Random(){
+	std::random_device rd;
+	std::array<unsigned int,4*n_lanes_*2> seedarray; std::generate_n(seedarray.data(), seedarray.size(), std::ref(rd));
+	std::seed_seq seeds(std::begin(seedarray), std::end(seedarray));
+	std::array<unsigned int,4*n_lanes_*2> words; seeds.generate(words.begin(), words.end());
+	unsigned long long* state[4] = {s0_, s1_, s2_, s3_};
+	for(int i=0; i<4*n_lanes_; ++i){state[i/n_lanes_][i%n_lanes_] = ((unsigned long long)words[2*i] << 32) | words[2*i+1];}
+	for(int l=0; l<n_lanes_; ++l){if((s0_[l] | s1_[l] | s2_[l] | s3_[l]) == 0){s0_[l] = 1;}} //the all zero state never leaves zero
+	i_uni_ = n_block_; i_az_ = n_block_; i_dir_ = n_block_;
+}
+
+//seed the generator for a reproducible stream, filling the state with splitmix64 (the seeding recommended for xoshiro)
+void Random::seed(unsigned long long seed_in, int stream){
+	unsigned long long* state[4] = {s0_, s1_, s2_, s3_};
+	for(int i=0; i<4*n_lanes_; ++i){
+		unsigned long long z = (seed_in += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL; z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		state[i/n_lanes_][i%n_lanes_] = z ^ (z >> 31);
+	}
+	for(int i=0; i<stream; ++i){jump();}
+	i_uni_ = n_block_; i_az_ = n_block_; i_dir_ = n_block_;
+}
+
+//skip ahead by 2^128 draws of every generator stream, with the jump polynomial published with xoshiro256
+void Random::jump(){
+	static const unsigned long long jumps[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+	unsigned long long j0[n_lanes_], j1[n_lanes_], j2[n_lanes_], j3[n_lanes_];
+	for(int l=0; l<n_lanes_; ++l){j0[l] = 0; j1[l] = 0; j2[l] = 0; j3[l] = 0;}
+	for(int i=0; i<4; ++i){
+		for(int b=0; b<64; ++b){
+			bool use = (jumps[i] >> b) & 1ULL;
+			#pragma omp simd
+			for(int l=0; l<n_lanes_; ++l){
+				if(use){j0[l] ^= s0_[l]; j1[l] ^= s1_[l]; j2[l] ^= s2_[l]; j3[l] ^= s3_[l];}
+				unsigned long long t = s1_[l] << 17;
+				s2_[l] ^= s0_[l]; s3_[l] ^= s1_[l]; s1_[l] ^= s2_[l]; s0_[l] ^= s3_[l];
+				s2_[l] ^= t; s3_[l] = (s3_[l] << 45) | (s3_[l] >> 19);
+			}
+		}
+	}
+	for(int l=0; l<n_lanes_; ++l){s0_[l] = j0[l]; s1_[l] = j1[l]; s2_[l] = j2[l]; s3_[l] = j3[l];}
+	i_uni_ = n_block_; i_az_ = n_block_; i_dir_ = n_block_;
+}
+
+//fill the uniform, azimuth and direction buffers, sized on first use so unused buffers cost nothing
+void Random::refill(){if(uni_.size() != n_block_){uni_.resize(n_block_);} uniform(uni_.data(), n_block_); i_uni_ = 0;}
+void Random::refill_az(){if(cph_.size() != n_block_){cph_.resize(n_block_); sph_.resize(n_block_);} azimuths(cph_.data(), sph_.data(), n_block_); i_az_ = 0;}
+void Random::refill_dir(){
+	if(ux_.size() != n_block_){ux_.resize(n_block_); uy_.resize(n_block_); uz_.resize(n_block_);}
+	directions(ux_.data(), uy_.data(), uz_.data(), n_block_); i_dir_ = 0;
+}
+
+//n uniform doubles in [0,1); the streams step together, one per vector lane
+//the top 52 bits of each output are put in the mantissa of a double in [1,2), then shifted down, to avoid an integer to double conversion
+void Random::uniform(double* out, int n){
+	unsigned long long s0[n_lanes_], s1[n_lanes_], s2[n_lanes_], s3[n_lanes_];
+	std::memcpy(s0, s0_, sizeof(s0)); std::memcpy(s1, s1_, sizeof(s1)); std::memcpy(s2, s2_, sizeof(s2)); std::memcpy(s3, s3_, sizeof(s3));
+	
+	for(int i=0; i<n; i+=n_lanes_){
+		double vals[n_lanes_];
+		#pragma omp simd
+		for(int l=0; l<n_lanes_; ++l){
+			unsigned long long res = s0[l] + s3[l];
+			unsigned long long t = s1[l] << 17;
+			s2[l] ^= s0[l]; s3[l] ^= s1[l]; s1[l] ^= s2[l]; s0[l] ^= s3[l];
+			s2[l] ^= t; s3[l] = (s3[l] << 45) | (s3[l] >> 19);
+			unsigned long long bits = (res >> 12) | 0x3FF0000000000000ULL;
+			double d; std::memcpy(&d, &bits, sizeof(d)); vals[l] = d - 1.;
+		}
+		int n_copy = (n - i < n_lanes_) ? n - i : n_lanes_;
+		for(int l=0; l<n_copy; ++l){out[i+l] = vals[l];}
+	}
+	
+	std::memcpy(s0_, s0, sizeof(s0)); std::memcpy(s1_, s1, sizeof(s1)); std::memcpy(s2_, s2, sizeof(s2)); std::memcpy(s3_, s3, sizeof(s3));
+}
+
+//n azimuths, as the cos and sin of a uniform angle in [0, 2pi)
+void Random::azimuths(double* cos_ph, double* sin_ph, int n){
+	uniform(cos_ph, n); sincos2pi(cos_ph, cos_ph, sin_ph, n);
+}
+
+//n isotropic unit vectors; cos(theta) is uniform in [-1,1), so sin(theta) follows from a sqrt with no acos
+void Random::directions(double* x, double* y, double* z, int n){
+	uniform(z, n); uniform(x, n); sincos2pi(x, x, y, n);
+	#pragma omp simd
+	for(int i=0; i<n; ++i){
+		double cth = 2.*z[i] - 1.; double sth = std::sqrt(1. - cth*cth);
+		x[i] *= sth; y[i] *= sth; z[i] = cth;
+	}
+}
+
+//cos and sin of 2*pi*u, vectorized
+//u is split into the nearest quarter turn q and a remainder a in [-pi/4, pi/4], Taylor series in a are then rotated by q quarter turns
+//the series are cut after a^13 (sin) and a^14 (cos), leaving an error below 2e-14 at the ends of the range
+//the output arrays may be the same as the input array
+void Random::sincos2pi(const double* u, double* cos_out, double* sin_out, int n){
+	const double two_pi = 6.28318530717958647692;
+	#pragma omp simd
+	for(int i=0; i<n; ++i){
+		double q = std::floor(4.*u[i] + 0.5); int iq = int(q) & 3;
+		double a = two_pi*(u[i] - 0.25*q); double a2 = a*a;
+		double s = a*(1. + a2*(-1./6. + a2*(1./120. + a2*(-1./5040. + a2*(1./362880. + a2*(-1./39916800. + a2*(1./6227020800.)))))));
+		double c = 1. + a2*(-1./2. + a2*(1./24. + a2*(-1./720. + a2*(1./40320. + a2*(-1./3628800. + a2*(1./479001600. + a2*(-1./87178291200.)))))));
+		double co = (iq == 0) ? c : (iq == 1) ? -s : (iq == 2) ? -c : s;
+		double si = (iq == 0) ? s : (iq == 1) ? c : (iq == 2) ? -s : -c;
+		cos_out[i] = co; sin_out[i] = si;
+	}
+}
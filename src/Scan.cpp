@@ -0,0 +1,301 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Scan.cpp
+*
+* Description: Parameter scan, runs many collision configurations in one process over a shared pool of worker threads
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include "Scan.h"
+#include "Event.h"
+#include "Nucleus.h"
+#include "Random.h"
+#include "Tuner.h"
+#include "Topology.h"
+
+//reads the scan file named in base.scanfile; base holds the values used for any tag not given on a line
+Scan::Scan(const Settings& base) : seed_(base.seed), next_block_(0) {
+	std::ifstream scanfile(base.scanfile.c_str()); std::string line;
+	if(!scanfile.is_open()){
+		std::cout << "\n\nScan file " << base.scanfile << " could not be opened.\n\n";
+		exit(EXIT_FAILURE);
+	}
+	
+	//every non-comment line is a configuration
+	while(std::getline(scanfile, line)){
+		if((line.empty()) || (line.front() == '#')){continue;}
+		std::stringstream linestream(line); std::string tag; std::string val;
+		Settings config = base; config.scanfile = ""; bool outset = false;
+		while(linestream >> tag >> val){
+			if((tag == "setfile") || (tag == "scanfile") || (!config.set(tag, val))){
+				std::cout << " Tag " << tag << " on scan line " << configs_.size()+1 << " was not recognized and is ignored.\n";
+			}
+			if(tag == "outfile"){outset = true;}
+		}
+		
+		//the single run features, and a seed of its own, are rejected rather than ignored
+		std::string conflict = config.scan_conflict();
+		if(conflict.empty() && (config.seed != base.seed)){conflict = "The seed of a scan is shared by all configurations and cannot be set per line.";}
+		if(!conflict.empty()){
+			std::cout << "\n\n" << conflict << "\nGiven on scan line " << configs_.size()+1 << ".\n\n";
+			exit(EXIT_FAILURE);
+		}
+		
+		//without an explicit outfile, the configuration number is added to the base output filename so outputs are not overwritten
+		if(!outset){config.outfile = Settings::tag_file(config.outfile, "_scan" + std::to_string(configs_.size()));}
+		configs_.push_back(config);
+	}
+	if(configs_.empty()){
+		std::cout << "\n\nScan file " << base.scanfile << " does not list any configurations.\n\n";
+		exit(EXIT_FAILURE);
+	}
+	
+	//finding species, and reading each bin file only once
+	std::map<std::string, std::vector<double> > bins;
+	n_eve_max_ = 0;
+	for(int icon=0; icon<configs_.size(); ++icon){
+		Settings& config = configs_[icon];
+		spec_a_.push_back(species(config.nuctypea, config.num_pro_a, config.num_neu_a));
+		spec_b_.push_back(species(config.nuctypeb, config.num_pro_b, config.num_neu_b));
+		
+		if(bins.count(config.binfile_n) == 0){bins[config.binfile_n] = Settings::read_bins(config.binfile_n);}
+		if(bins.count(config.binfile_a) == 0){bins[config.binfile_a] = Settings::read_bins(config.binfile_a);}
+		stats_.push_back(Stats(bins[config.binfile_n], bins[config.binfile_a], config.ecc, config.hotspots, config.needed_observables()));
+		if(config.cent_obs >= 0){stats_.back().centrality(config.cent_obs, config.cent_classes, config.cent_k);}
+		
+		if(config.n_eve > n_eve_max_){n_eve_max_ = config.n_eve;}
+	}
+	
+	//checking the species settings up front (Nucleus exits on bad settings) so it doesn't happen partway through a run in a worker
+	for(int ispec=0; ispec<species_.size(); ++ispec){Nucleus check(species_[ispec].type, species_[ispec].npro, species_[ispec].nneu);}
+	
+	//picking the collision kernel of each configuration and the hard-core check of each species (from the first configuration using it)
+	hardcore_.assign(species_.size(), -1);
+	for(int icon=0; icon<configs_.size(); ++icon){
+		Tuner tuner(configs_[icon]); strategy_.push_back(tuner.strategy());
+		if(hardcore_[spec_a_[icon]] < 0){hardcore_[spec_a_[icon]] = tuner.hardcore_a();}
+		if(hardcore_[spec_b_[icon]] < 0){hardcore_[spec_b_[icon]] = tuner.hardcore_b();}
+		std::cout << "  Configuration " << icon << ": " << tuner.describe() << "\n";
+	}
+	
+	n_blocks_ = (n_eve_max_ + block_size_ - 1)/block_size_; done_blocks_ = 0;
+}
+
+//find (or add) the species index for a nucleus
+int Scan::species(int type_in, int npro_in, int nneu_in){
+	for(int ispec=0; ispec<species_.size(); ++ispec){
+		if((species_[ispec].type == type_in) && (species_[ispec].npro == npro_in) && (species_[ispec].nneu == nneu_in)){return ispec;}
+	}
+	Species spec = {type_in, npro_in, nneu_in};
+	species_.push_back(spec);
+	
+return species_.size()-1;
+}
+
+//add an event holding the collision settings of a configuration, built in place rather than copied
+void Scan::add_event(std::vector<Event>& events, int icon){
+	Settings& config = configs_[icon];
+	events.emplace_back(config.nuctypea, config.num_pro_a, config.num_neu_a, config.nuctypeb, config.num_pro_b, config.num_neu_b, config.coll_dist);
+	Event& event = events.back();
+	event.single(config.single_prec); event.ecc(config.ecc); event.strategy(strategy_[icon]);
+	event.hotspots(config.hotspots, config.hs_dist, config.hs_width); event.profile(config.profile, config.prof_amp);
+	event.observables(config.needed_observables());
+}
+
+//measured time of one event of the scan, with the collision passes unsplit and split over the pool
+//as in Tuner, the same nuclei are collided a few times per round and the fastest round is kept; the nuclei and events are separate from
+//those of the workers, so the random streams of the run are untouched
+void Scan::measure(TaskPool& pool, double& t_events, double& t_split){
+	std::vector<Nucleus> nuc_a; std::vector<Nucleus> nuc_b; std::vector<Event> events;
+	for(int ispec=0; ispec<species_.size(); ++ispec){
+		nuc_a.push_back(Nucleus(species_[ispec].type, species_[ispec].npro, species_[ispec].nneu));
+		nuc_b.push_back(Nucleus(species_[ispec].type, species_[ispec].npro, species_[ispec].nneu));
+		nuc_a.back().hardcore(hardcore_[ispec]); nuc_b.back().hardcore(hardcore_[ispec]);
+	}
+	events.reserve(configs_.size()); for(int icon=0; icon<configs_.size(); ++icon){add_event(events, icon);}
+	std::vector<bool> used_a(species_.size(), false); std::vector<bool> used_b(species_.size(), false);
+	for(int icon=0; icon<configs_.size(); ++icon){used_a[spec_a_[icon]] = true; used_b[spec_b_[icon]] = true;}
+	
+	//the fills, then the collisions unsplit and split, each configuration weighted by its share of the events
+	double best[3] = {1.e300, 1.e300, 1.e300};
+	for(int iround=0; iround<n_rounds_; ++iround){
+		double t[3] = {0., 0., 0.};
+		std::chrono::steady_clock::time_point tstart = std::chrono::steady_clock::now();
+		for(int ispec=0; ispec<species_.size(); ++ispec){
+			if(used_a[ispec]){nuc_a[ispec].fill();}
+			if(used_b[ispec]){nuc_b[ispec].fill();}
+		}
+		t[0] = std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart).count();
+		for(int isplit=0; isplit<2; ++isplit){
+			for(int icon=0; icon<configs_.size(); ++icon){
+				events[icon].pool(isplit ? &pool : nullptr); double weight = double(configs_[icon].n_eve)/n_eve_max_;
+				tstart = std::chrono::steady_clock::now();
+				for(int icoll=0; icoll<n_coll_; ++icoll){events[icon].collide(nuc_a[spec_a_[icon]], nuc_b[spec_b_[icon]]);}
+				t[1+isplit] += weight*std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart).count()/n_coll_;
+			}
+		}
+		for(int it=0; it<3; ++it){if(t[it] < best[it]){best[it] = t[it];}}
+	}
+	t_events = best[0] + best[1]; t_split = best[0] + best[2];
+}
+
+//run all configurations with n_threads worker threads and write one output file per configuration
+void Scan::run(int n_threads, int pin, int parallel){
+	if(n_threads <= 0){n_threads = std::thread::hardware_concurrency();}
+	if(n_threads <= 0){n_threads = 1;}
+	
+	//placing the threads; unpinned threads all count as node 0, so they merge straight into one set of statistics
+	Topology topology; int n_nodes = (pin > 0) ? topology.n_nodes() : 1;
+	std::vector<int> cpu(n_threads, -1); std::vector<int> node(n_threads, 0);
+	if(pin > 0){for(int ithr=0; ithr<n_threads; ++ithr){topology.place(ithr, pin, cpu[ithr], node[ithr]);}}
+	
+	std::cout << "\n\n";
+	std::cout << "Running a scan of " << configs_.size() << " configurations (" << species_.size() << " distinct nuclei, up to " << n_eve_max_ <<
+	  " events each) on " << n_threads << " threads.\n";
+	if(pin > 0){
+		std::cout << "Threads pinned " << ((pin == 1) ? "compact" : "scatter") << " over " << n_nodes << " NUMA node" << ((n_nodes > 1) ? "s" : "") << ":";
+		for(int ithr=0; ithr<n_threads; ++ithr){std::cout << " " << cpu[ithr] << "(" << node[ithr] << ")";}
+		std::cout << "\n";
+	}
+	
+	//event level or split parallelism: with events on separate threads, the run takes as long as the blocks of the busiest thread,
+	//with every event split, as long as all the events one after the other
+	std::unique_ptr<TaskPool> pool; bool split = false;
+	if((n_threads > 1) && (parallel != 0)){
+		pool.reset(new TaskPool(n_threads, cpu));
+		if(parallel == 1){split = true;}
+		else{
+			double t_events, t_split; measure(*pool, t_events, t_split);
+			double run_events = std::min((n_blocks_ + n_threads - 1)/n_threads*block_size_, n_eve_max_)*t_events; double run_split = n_eve_max_*t_split;
+			split = (run_split < run_events);
+			std::cout << "Measured " << t_events*1.e3 << " ms per event on one thread, " << t_split*1.e3 << " ms split over " << n_threads << " threads.\n";
+		}
+		if(!split){pool.reset();}
+	}
+	std::cout << (split ? "Every event is split over all threads." : "Events are run on separate threads.") << "\n";
+	std::cout << "\n\n";
+	
+	//running the worker threads, or a single one splitting every event over the pool
+	auto tstart = std::chrono::steady_clock::now();
+	next_block_ = 0; done_blocks_ = 0;
+	node_stats_.clear(); node_stats_.resize(n_nodes); node_lock_.reset(new std::mutex[n_nodes]);
+	std::vector<std::thread> workers;
+	if(split){workers.push_back(std::thread(&Scan::work, this, cpu[0], node[0], pool.get()));}
+	else{for(int ithr=0; ithr<n_threads; ++ithr){workers.push_back(std::thread(&Scan::work, this, cpu[ithr], node[ithr], nullptr));}}
+	for(int ithr=0; ithr<workers.size(); ++ithr){workers[ithr].join();}
+	
+	//merging the nodes into the totals
+	for(int inode=0; inode<n_nodes; ++inode){
+		for(int icon=0; icon<node_stats_[inode].size(); ++icon){stats_[icon].merge(node_stats_[inode][icon]);}
+	}
+	node_stats_.clear();
+	double trun = std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart).count();
+	
+	//Event loop completion message
+	std::cout << "All requested events have been generated.  Writing out statistics and closing.\n\n";
+	for(int icon=0; icon<configs_.size(); ++icon){
+		stats_[icon].write(configs_[icon].outfile);
+		std::cout << "  Configuration " << icon << ": " << stats_[icon].n_eve() << " events written to " << configs_[icon].outfile << "\n";
+	}
+	std::cout << "\nTime taken was " << trun/60. << " minutes \n";
+}
+
+//worker thread body, pins itself to cpu (if >= 0) and generates blocks of events until none are left
+void Scan::work(int cpu, int node, TaskPool* pool){
+	//pinning before anything is allocated, so this worker's nuclei, events and statistics are first touched on its own node
+	if((cpu >= 0) && !Topology::pin(cpu)){
+		std::lock_guard<std::mutex> lock(merge_lock_);
+		std::cout << "  Could not pin a worker thread to CPU " << cpu << ", it is left unpinned.\n";
+	}
+	
+	//private nuclei for this worker: one sample per species and side, so that e.g. Pb+Pb still collides two independent nuclei
+	std::vector<Nucleus> nuc_a; std::vector<Nucleus> nuc_b;
+	for(int ispec=0; ispec<species_.size(); ++ispec){
+		nuc_a.push_back(Nucleus(species_[ispec].type, species_[ispec].npro, species_[ispec].nneu));
+		nuc_b.push_back(Nucleus(species_[ispec].type, species_[ispec].npro, species_[ispec].nneu));
+		nuc_a.back().hardcore(hardcore_[ispec]); nuc_b.back().hardcore(hardcore_[ispec]);
+	}
+	
+	//private events (holding the collision settings and impact parameter RNG) and statistics for each configuration
+	std::vector<Event> events; std::vector<Stats> stats; events.reserve(configs_.size());
+	for(int icon=0; icon<configs_.size(); ++icon){
+		add_event(events, icon); events.back().pool(pool);
+		stats.push_back(stats_[icon]); //copy of the (still empty) merged statistics, to get the binning
+	}
+	
+	//seeded scans: one generator per nucleus species and side and per configuration, seeded with seed_ plus its index, and block iblk of the
+	//events uses stream iblk of each (see Random::seed); the cursors are kept at the stream of the next block, and since the blocks of a worker
+	//only increase they are jumped ahead to it rather than reseeded, then handed to the nuclei and events
+	std::vector<Random> cursors; int i_stream = 0;
+	if(seed_ != 0){
+		cursors.resize(2*species_.size() + configs_.size());
+		for(int ir=0; ir<cursors.size(); ++ir){cursors[ir].seed(seed_ + ir);}
+	}
+	
+	//taking blocks of events until none are left
+	std::vector<bool> fill_a(species_.size()); std::vector<bool> fill_b(species_.size());
+	for(int iblk=next_block_++; iblk<n_blocks_; iblk=next_block_++){
+		int i_end = std::min((iblk+1)*block_size_, n_eve_max_);
+		if(seed_ != 0){
+			for(; i_stream<iblk; ++i_stream){for(int ir=0; ir<cursors.size(); ++ir){cursors[ir].jump();}}
+			for(int ispec=0; ispec<species_.size(); ++ispec){nuc_a[ispec].seed(cursors[2*ispec]); nuc_b[ispec].seed(cursors[2*ispec+1]);}
+			for(int icon=0; icon<configs_.size(); ++icon){events[icon].seed(cursors[2*species_.size()+icon]);}
+		}
+		for(int i_eve=iblk*block_size_; i_eve<i_end; ++i_eve){
+			//filling each species used by a configuration that still needs this event, once
+			for(int ispec=0; ispec<species_.size(); ++ispec){fill_a[ispec] = false; fill_b[ispec] = false;}
+			for(int icon=0; icon<configs_.size(); ++icon){
+				if(i_eve < configs_[icon].n_eve){fill_a[spec_a_[icon]] = true; fill_b[spec_b_[icon]] = true;}
+			}
+			for(int ispec=0; ispec<species_.size(); ++ispec){
+				if(fill_a[ispec]){nuc_a[ispec].fill();}
+				if(fill_b[ispec]){nuc_b[ispec].fill();}
+			}
+			
+			//colliding the shared nuclei for each configuration
+			for(int icon=0; icon<configs_.size(); ++icon){
+				if(i_eve >= configs_[icon].n_eve){continue;}
+				events[icon].collide(nuc_a[spec_a_[icon]], nuc_b[spec_b_[icon]]);
+				stats[icon].fill(events[icon]);
+			}
+		}
+		
+		//keeping track of progress; reporting roughly every 10% of blocks
+		std::lock_guard<std::mutex> lock(merge_lock_);
+		++done_blocks_;
+		if((done_blocks_ % std::max(1, n_blocks_/10) == 0) || (done_blocks_ == n_blocks_)){
+			std::cout << "  " << done_blocks_ << " out of " << n_blocks_ << " event blocks generated   " << ((double)done_blocks_/n_blocks_)*100. << "% finished \n";
+		}
+	}
+	
+	//merging this worker's statistics into those of its node; the first worker to finish on a node hands over its own
+	std::lock_guard<std::mutex> lock(node_lock_[node]);
+	if(node_stats_[node].empty()){node_stats_[node].swap(stats);}
+	else{for(int icon=0; icon<configs_.size(); ++icon){node_stats_[node][icon].merge(stats[icon]);}}
+}
@@ -0,0 +1,267 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Settings.cpp
+*
+* Description: Run parameters with their defaults, read from command line switches, a settings file, or a line of a scan file
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <fstream>
+#include <sstream>
+#include "Settings.h"
+#include "Event.h"
+
+//default values
+Settings::Settings(){
+	nuctypea  = 2  ; //heavy nucleus a
+	nuctypeb  = 2  ; //heavy nucleus b
+	num_pro_a = 82 ; //number of protons in a lead 208 nucleus
+	num_pro_b = 82 ; //number of protons in a lead 208 nucleus
+	num_neu_a = 126; //number of neutrons in a lead 208 nucleus
+	num_neu_b = 126; //number of neutrons in a lead 208 nucleus
+	n_eve     = 1000; //default number of events is 1k
+	coll_dist = 1. ; //nucleon-nucleon collision distance in fm
+	n_threads = 0  ; //use all available hardware threads in scan mode
+	pin       = 0  ; //worker threads are not pinned
+	parallel  = -1 ; //scan parallelism picked from the measured event cost
+	single_prec = false; //double precision positions and collision kernel
+	validate  = false; //no precision validation
+	ecc       = false; //no eccentricities
+	grid_mode = 0  ; //no transverse grid output
+	observables = Event::OBS_ALL; //every observable
+	optical   = false; //Monte Carlo events
+	opt_step  = 0.5; //optical Glauber output every 0.5 fm in b
+	xsec      = 0  ; //events are generated, no fast sigma_inel mode
+	cent_obs  = -1 ; //no centrality classes
+	cent_classes = 10; //of 10% each
+	cent_k    = 1000; //rank error of about 0.2%
+	grid_n    = 100; //100x100 grid
+	grid_step = 0.2; //of 0.2 fm cells
+	grid_width= 0.5; //with sources of 0.5 fm width
+	seed      = 0  ; //seeded from std::random_device
+	shard_i   = 0  ; //a single shard
+	shard_n   = 1  ; //holding all of the events
+	target    = 0. ; //no adaptive stopping
+	target_obs= 0  ; //on the n_coll histogram
+	target_mean = false; //error of the bin entries
+	target_lo = 0  ; //over all bins
+	target_hi = -1 ;
+	coll_kernel = -1; //autotuned collision kernel
+	hardcore  = -1 ; //autotuned hard-core check
+	status_every = 1000; //status file updated every 1000 events
+	profile   = 0  ; //black disk collisions
+	prof_amp  = 1. ; //with full opacity
+	hotspots  = 0  ; //nucleon level collisions
+	hs_dist   = 0.4; //hotspot collision distance in fm
+	hs_width  = 0.3; //hotspot spread about the nucleon center in fm
+	nuc_res   = 0.001; //nucleon file positions to 0.001 fm
+	nuc_delta = false; //without delta encoding
+	
+	binfile_n   = "settings/binfile_n.dat";
+	binfile_a   = "settings/binfile_a.dat";
+	settingfile = "settings/settings.dat";
+	outfile     = "output/output.dat";
+	scanfile    = "";
+	gridfile    = "output/grid.dat";
+	statefile   = "";
+	tunefile    = ""; //no cache by default, so the library touches no files; Collider.out sets its own
+	statusfile  = "";
+	nucfile     = "";
+}
+
+//set a parameter from its tag and a string value; returns false if the tag is not recognized
+bool Settings::set(const std::string& tag, const std::string& val){
+	if(     tag == "NumE"     ){n_eve       = std::stoi(val);}
+	else if(tag == "nucA"     ){nuctypea    = std::stoi(val);}
+	else if(tag == "nucB"     ){nuctypeb    = std::stoi(val);}
+	else if(tag == "nproA"    ){num_pro_a   = std::stoi(val);}
+	else if(tag == "nproB"    ){num_pro_b   = std::stoi(val);}
+	else if(tag == "nneuA"    ){num_neu_a   = std::stoi(val);}
+	else if(tag == "nneuB"    ){num_neu_b   = std::stoi(val);}
+	else if(tag == "colldist" ){coll_dist   = std::stod(val);}
+	else if(tag == "threads"  ){n_threads   = std::stoi(val);}
+	else if(tag == "pin"      ){
+		if(     val == "none"   ){pin = 0;}
+		else if(val == "compact"){pin = 1;}
+		else if(val == "scatter"){pin = 2;}
+		else{return false;}
+	}
+	else if(tag == "parallel" ){
+		if(     val == "auto"  ){parallel = -1;}
+		else if(val == "events"){parallel = 0;}
+		else if(val == "split" ){parallel = 1;}
+		else{return false;}
+	}
+	else if(tag == "precision"){single_prec = (val == "float" || val == "single");}
+	else if(tag == "validate" ){validate    = (std::stoi(val) != 0);}
+	else if(tag == "ecc"      ){ecc         = (std::stoi(val) != 0);}
+	else if(tag == "xsec"     ){xsec        = std::stoi(val);}
+	else if(tag == "grid"     ){grid_mode   = std::stoi(val);}
+	else if(tag == "centrality"){
+		if(     val == "none" ){cent_obs = -1;}
+		else if(val == "ncoll"){cent_obs = 0;}
+		else if(val == "npart"){cent_obs = 1;}
+		else if(val == "area" ){cent_obs = 2;}
+		else{return false;}
+	}
+	else if(tag == "optical"  ){optical     = (std::stoi(val) != 0);}
+	else if(tag == "opticalstep"){opt_step  = std::stod(val);}
+	else if(tag == "centclasses"){cent_classes = std::stoi(val);}
+	else if(tag == "centk"    ){cent_k      = std::stoi(val);}
+	else if(tag == "observables"){
+		//a comma separated list; n_coll is always counted, so ncoll alone computes nothing else
+		int obs = 0; std::stringstream list(val); std::string name;
+		while(std::getline(list, name, ',')){
+			if(     name == "ncoll"    ){}
+			else if(name == "npart"    ){obs |= Event::OBS_NPART;}
+			else if(name == "area"     ){obs |= Event::OBS_AREA;}
+			else if(name == "midpoints"){obs |= Event::OBS_MIDPOINTS;}
+			else if(name == "all"      ){obs |= Event::OBS_ALL;}
+			else{return false;}
+		}
+		observables = obs;
+	}
+	else if(tag == "gridsize" ){grid_n      = std::stoi(val);}
+	else if(tag == "gridstep" ){grid_step   = std::stod(val);}
+	else if(tag == "gridwidth"){grid_width  = std::stod(val);}
+	else if(tag == "gridfile" ){gridfile    = val;}
+	else if(tag == "seed"     ){seed        = std::stoull(val);}
+	else if(tag == "shard"    ){
+		std::size_t slash = val.find('/'); if(slash == std::string::npos){return false;}
+		shard_i = std::stoi(val.substr(0, slash)); shard_n = std::stoi(val.substr(slash+1));
+	}
+	else if(tag == "statefile"){statefile   = val;}
+	else if(tag == "collkernel"){
+		if(     val == "auto"  ){coll_kernel = -1;}
+		else if(val == "all"   ){coll_kernel = 0;}
+		else if(val == "sorted"){coll_kernel = 1;}
+		else{return false;}
+	}
+	else if(tag == "hardcore" ){
+		if(     val == "auto" ){hardcore = -1;}
+		else if(val == "scan" ){hardcore = 0;}
+		else if(val == "cells"){hardcore = 1;}
+		else{return false;}
+	}
+	else if(tag == "tunefile" ){tunefile    = val;}
+	else if(tag == "statusfile"){statusfile = val;}
+	else if(tag == "statusevery"){status_every = std::stoi(val);}
+	else if(tag == "profile"  ){
+		if(     val == "black"){profile = 0;}
+		else if(val == "gray" ){profile = 1;}
+		else if(val == "gauss"){profile = 2;}
+		else{return false;}
+	}
+	else if(tag == "profamp"  ){prof_amp    = std::stod(val);}
+	else if(tag == "hotspots" ){hotspots    = std::stoi(val);}
+	else if(tag == "hsdist"   ){hs_dist     = std::stod(val);}
+	else if(tag == "hswidth"  ){hs_width    = std::stod(val);}
+	else if(tag == "nucfile"  ){nucfile     = val;}
+	else if(tag == "nucres"   ){nuc_res     = std::stod(val);}
+	else if(tag == "nucdelta" ){nuc_delta   = (std::stoi(val) != 0);}
+	else if(tag == "target"   ){target      = std::stod(val);}
+	else if(tag == "targetobs"){
+		if(     val == "ncoll"){target_obs = 0;}
+		else if(val == "npart"){target_obs = 1;}
+		else if(val == "area" ){target_obs = 2;}
+		else{return false;}
+	}
+	else if(tag == "targeterr"){
+		if(     val == "mean"){target_mean = true;}
+		else if(val == "val" ){target_mean = false;}
+		else{return false;}
+	}
+	else if(tag == "targetbins"){
+		std::size_t slash = val.find('/'); if(slash == std::string::npos){return false;}
+		target_lo = std::stoi(val.substr(0, slash)); target_hi = std::stoi(val.substr(slash+1));
+	}
+	else if(tag == "binfilen" ){binfile_n   = val;}
+	else if(tag == "binfilea" ){binfile_a   = val;}
+	else if(tag == "setfile"  ){settingfile = val;}
+	else if(tag == "outfile"  ){outfile     = val;}
+	else if(tag == "scanfile" ){scanfile    = val;}
+	else{return false;}
+	
+return true;
+}
+
+//need to read-in and parse settings file.  Then overwrite default values with values there, but ONLY if it wasn't already overridden on command line
+void Settings::read(const std::string& filename, const std::set<std::string>& locked){
+	std::ifstream settings(filename.c_str()); std::string line;
+	while(std::getline(settings, line)){
+		//lines beginning with # denote comments
+		if((line.empty()) || (line.front() == '#')){continue;}
+		
+		//parsing line into 2 strings
+		std::stringstream argstream(line);
+		std::string str1; std::string str2;
+		if(!(argstream >> str1 >> str2)){continue;}
+		
+		//the settings file cannot point to another settings file
+		if((str1 == "setfile") || (locked.count(str1) > 0)){continue;}
+		set(str1, str2);
+	}
+}
+
+//read a list of bin ends from a bin file
+std::vector<double> Settings::read_bins(const std::string& filename){
+	std::vector<double> bins; double binval = 0.;
+	std::ifstream binning(filename.c_str());
+	while(binning >> binval){bins.push_back(binval);}
+	
+return bins;
+}
+
+//observables the collision kernel has to compute
+int Settings::needed_observables() const {
+	int obs = observables;
+	if(ecc || (grid_mode == 1) || !nucfile.empty()){obs |= Event::OBS_NPART;}
+	if(grid_mode == 2){obs |= Event::OBS_MIDPOINTS;}
+	if(cent_obs >= 0){obs |= Event::OBS_NPART | ((cent_obs == 2) ? Event::OBS_AREA : 0);}
+	if(target > 0.){obs |= (target_obs == 1) ? Event::OBS_NPART : (target_obs == 2) ? Event::OBS_AREA : 0;}
+	
+return obs;
+}
+
+//the reason these settings cannot run in scan mode, or "" if they can
+std::string Settings::scan_conflict() const {
+	if(shard_n > 1){return "Sharding is not supported in scan mode.";}
+	if(target > 0.){return "A precision target is not supported in scan mode.";}
+	if(!statusfile.empty()){return "A status file is not supported in scan mode.";}
+	if(!nucfile.empty()){return "A nucleon file is not supported in scan mode.";}
+	if(optical){return "The optical Glauber model is not supported in scan mode.";}
+	if(xsec > 0){return "The cross section mode is not supported in scan mode.";}
+	if(grid_mode > 0){return "A density grid is not supported in scan mode.";}
+	if(validate){return "Validation of the collision precision is not supported in scan mode.";}
+	
+return "";
+}
+
+//insert tagname before the extension of filename (or append it if there is none)
+std::string Settings::tag_file(const std::string& filename, const std::string& tagname){
+	std::string out = filename;
+	std::size_t dot = out.find_last_of('.'); std::size_t slash = out.find_last_of('/');
+	if((dot == std::string::npos) || ((slash != std::string::npos) && (dot < slash))){out += tagname;}
+	else{out.insert(dot, tagname);}
+	
+return out;
+}
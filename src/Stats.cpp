@@ -0,0 +1,194 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Stats.cpp
+*
+* Description: Collection of the event statistic histograms for a single run configuration
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cmath>
+#include "Stats.h"
+
+//state files start with this tag and a format version
+static const char state_tag[8] = {'G','L','S','T','A','T','E','4'};
+
+//bins_n are the bin ends for n_coll and n_part, bins_a are the bin ends for the overlap area
+Stats::Stats(std::vector<double>& bins_n, std::vector<double>& bins_a, bool ecc, int hotspots, int observables) :
+  h_n_coll_(bins_n.data(), bins_n.size()-1), h_n_part_(bins_n.data(), bins_n.size()-1), h_area_(bins_a.data(), bins_a.size()-1) {
+	n_eve_ = 0; obs_ = observables; cent_obs_ = -1; cent_classes_ = 0;
+	if(ecc){
+		double bins_ecc[n_bins_ecc_+1];
+		for(int ibin=0; ibin<=n_bins_ecc_; ++ibin){bins_ecc[ibin] = double(ibin)/n_bins_ecc_;}
+		for(int n=2; n<=6; ++n){h_ecc_.push_back(Histogram<double>(bins_ecc, n_bins_ecc_));}
+	}
+	if(hotspots > 0){
+		std::vector<double> bins_hs(bins_n);
+		for(int ibin=0; ibin<bins_hs.size(); ++ibin){bins_hs[ibin] *= hotspots;}
+		h_hs_.push_back(Histogram<double>(bins_hs.data(), bins_hs.size()-1)); h_hs_.push_back(Histogram<double>(bins_hs.data(), bins_hs.size()-1));
+	}
+}
+
+//reading the histograms of a binary state, after its header; the order is the one written by write_state
+Stats::Stats(std::istream& in) : h_n_coll_(in), h_n_part_(in), h_area_(in) {
+	int n_ecc = 0; in.read((char*)&n_ecc, sizeof(n_ecc));
+	for(int iecc=0; in && iecc<n_ecc; ++iecc){h_ecc_.push_back(Histogram<double>(in));}
+	int n_hs = 0; in.read((char*)&n_hs, sizeof(n_hs));
+	for(int ihs=0; in && ihs<n_hs; ++ihs){h_hs_.push_back(Histogram<double>(in));}
+	cent_obs_ = -1; cent_classes_ = 0; in.read((char*)&cent_obs_, sizeof(cent_obs_)); in.read((char*)&cent_classes_, sizeof(cent_classes_));
+	if(in && (cent_obs_ >= 0)){cent_.push_back(QuantileSketch(in));}
+	if(in){xsec_ = CrossSection(in);}
+	n_eve_ = 0; in.read((char*)&n_eve_, sizeof(n_eve_));
+	obs_ = Event::OBS_ALL;
+}
+
+//writing the full binary state of the histograms to statefile
+void Stats::write_state(const std::string& statefile) const {
+	std::ofstream out(statefile.c_str(), std::ios::binary);
+	write_state(out);
+	if(!out){std::cout << "\n\nCould not write the state file " << statefile << ".\n\n"; exit(EXIT_FAILURE);}
+}
+
+//writing the full binary state of the histograms to a stream
+void Stats::write_state(std::ostream& out) const {
+	out.write(state_tag, sizeof(state_tag));
+	h_n_coll_.write_state(out); h_n_part_.write_state(out); h_area_.write_state(out);
+	int n_ecc = h_ecc_.size(); out.write((const char*)&n_ecc, sizeof(n_ecc));
+	for(int iecc=0; iecc<n_ecc; ++iecc){h_ecc_[iecc].write_state(out);}
+	int n_hs = h_hs_.size(); out.write((const char*)&n_hs, sizeof(n_hs));
+	for(int ihs=0; ihs<n_hs; ++ihs){h_hs_[ihs].write_state(out);}
+	out.write((const char*)&cent_obs_, sizeof(cent_obs_)); out.write((const char*)&cent_classes_, sizeof(cent_classes_));
+	if(!cent_.empty()){cent_[0].write_state(out);}
+	xsec_.write_state(out);
+	out.write((const char*)&n_eve_, sizeof(n_eve_));
+}
+
+//reading a binary state file back
+Stats Stats::read_state(const std::string& statefile){
+	std::ifstream in(statefile.c_str(), std::ios::binary);
+	
+return read_state(in, statefile);
+}
+
+//reading a binary state back from a stream, name is the file or source reported on errors
+Stats Stats::read_state(std::istream& in, const std::string& name){
+	char tag[sizeof(state_tag)] = {0}; in.read(tag, sizeof(tag));
+	if(!in || std::memcmp(tag, state_tag, sizeof(tag)) != 0){
+		std::cout << "\n\nThe file " << name << " is missing or is not a state file.\n\n"; exit(EXIT_FAILURE);
+	}
+	Stats stats(in);
+	if(!in){std::cout << "\n\nThe state file " << name << " is truncated.\n\n"; exit(EXIT_FAILURE);}
+	
+return stats;
+}
+
+//if another Stats object has the same histograms and binning
+bool Stats::same_bins(const Stats& other) const {
+	if(!h_n_coll_.same_bins(other.h_n_coll_) || !h_n_part_.same_bins(other.h_n_part_) || !h_area_.same_bins(other.h_area_)){return false;}
+	if(h_ecc_.size() != other.h_ecc_.size()){return false;}
+	for(int iecc=0; iecc<h_ecc_.size(); ++iecc){if(!h_ecc_[iecc].same_bins(other.h_ecc_[iecc])){return false;}}
+	if(h_hs_.size() != other.h_hs_.size()){return false;}
+	for(int ihs=0; ihs<h_hs_.size(); ++ihs){if(!h_hs_[ihs].same_bins(other.h_hs_[ihs])){return false;}}
+	if((cent_obs_ != other.cent_obs_) || (cent_classes_ != other.cent_classes_)){return false;}
+	if(!cent_.empty() && (cent_[0].k() != other.cent_[0].k())){return false;}
+	
+return true;
+}
+
+//largest relative error over a range of bins of one histogram
+double Stats::rel_err(int obs, bool mean, int lo, int hi){
+	Histogram<double>& hist = (obs == 0) ? h_n_coll_ : (obs == 1) ? h_n_part_ : h_area_;
+	if(hi < 0){hi += hist.n_bins();} if(hi >= hist.n_bins()){hi = hist.n_bins() - 1;} if(lo < 0){lo = 0;}
+	double err_max = -1.;
+	for(int ibin=lo; ibin<=hi; ++ibin){
+		if(hist.val_bin(ibin) == 0){continue;}
+		double err = mean ? hist.errmean_bin(ibin)/std::abs(hist.mean_bin(ibin)) : hist.errval_bin(ibin)/hist.val_bin(ibin);
+		if(std::isnan(err)){err = HUGE_VAL;} //a zero mean has no relative error
+		if(err > err_max){err_max = err;}
+	}
+	
+return err_max;
+}
+
+//writing the histograms to the output file
+void Stats::write(const std::string& outfile){
+	//opening up output file to write histograms to
+	std::ofstream fileout(outfile.c_str());
+	
+	//writing to file
+	fileout << "\n";
+	fileout << "N_coll Histogram:";
+	fileout << "N_coll, Entries";
+	for(int ihist=0; ihist<h_n_coll_.n_bins(); ++ihist){
+		fileout << h_n_coll_.mean_bin(ihist) << ", " << h_n_coll_.val_bin(ihist) << "\n";
+	}
+	fileout << "\n\n\n\n\n\n\n\n\n\n";
+	fileout << "N_part Histogram:";
+	fileout << "N_part, Entries";
+	for(int ihist=0; ihist<h_n_part_.n_bins(); ++ihist){
+		fileout << h_n_part_.mean_bin(ihist) << ", " << h_n_part_.val_bin(ihist) << "\n";
+	}
+	fileout << "\n\n\n\n\n\n\n\n\n\n";
+	fileout << "Area Histogram:";
+	fileout << "bin_AvgArea, Entries";
+	for(int ihist=0; ihist<h_area_.n_bins(); ++ihist){
+		fileout << h_area_.mean_bin(ihist) << ", " << h_area_.val_bin(ihist) << "\n";
+	}
+	for(int iecc=0; iecc<h_ecc_.size(); ++iecc){
+		fileout << "\n\n\n\n\n\n\n\n\n\n";
+		fileout << "Eps_" << iecc+2 << " Histogram:";
+		fileout << "bin_AvgEps_" << iecc+2 << ", Entries";
+		for(int ihist=0; ihist<h_ecc_[iecc].n_bins(); ++ihist){
+			fileout << h_ecc_[iecc].mean_bin(ihist) << ", " << h_ecc_[iecc].val_bin(ihist) << "\n";
+		}
+	}
+	const char* hs_names[2] = {"N_coll_hotspot", "N_part_hotspot"};
+	for(int ihs=0; ihs<h_hs_.size(); ++ihs){
+		fileout << "\n\n\n\n\n\n\n\n\n\n";
+		fileout << hs_names[ihs] << " Histogram:";
+		fileout << hs_names[ihs] << ", Entries";
+		for(int ihist=0; ihist<h_hs_[ihs].n_bins(); ++ihist){
+			fileout << h_hs_[ihs].mean_bin(ihist) << ", " << h_hs_[ihs].val_bin(ihist) << "\n";
+		}
+	}
+	if(!cent_.empty()){
+		const char* cent_names[3] = {"N_coll", "N_part", "Area"};
+		std::vector<QuantileSketch::Class> classes = cent_[0].classes(cent_classes_);
+		fileout << "\n\n\n\n\n\n\n\n\n\n";
+		fileout << "Centrality Classes (" << cent_names[cent_obs_] << "):";
+		fileout << "Centrality_lo%, Centrality_hi%, " << cent_names[cent_obs_] << "_lo, " << cent_names[cent_obs_] << "_hi, AvgN_coll, AvgN_part";
+		for(int icl=0; icl<classes.size(); ++icl){
+			fileout << classes[icl].pct_lo << ", " << classes[icl].pct_hi << ", " << classes[icl].key_lo << ", " << classes[icl].key_hi << ", " <<
+			  classes[icl].n_coll << ", " << classes[icl].n_part << "\n";
+		}
+	}
+	if(xsec_.n_samples() > 0){xsec_.write(fileout);}
+	fileout.close();
+}
+
+//also determine centrality classes of an observable, from a quantile sketch
+void Stats::centrality(int obs, int n_classes, int k){
+	if((obs < 0) || (obs > 2) || (n_classes < 1)){std::cout << "\n\nCentrality classes need an observable and at least one class.\n\n"; exit(EXIT_FAILURE);}
+	cent_obs_ = obs; cent_classes_ = n_classes; cent_.clear(); cent_.push_back(QuantileSketch(k));
+}
@@ -0,0 +1,111 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: StatusFile.cpp
+*
+* Description: Live run status in a memory-mapped file: event counters, throughput and the histogram state, readable at any time
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <thread>
+#include <chrono>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "StatusFile.h"
+
+//status files start with this tag and a format version
+static const char status_tag[8] = {'G','L','S','T','A','T','U','1'};
+
+//output stream buffer writing straight into a fixed block of memory, so an update needs no allocation
+struct MemoryBuffer : public std::streambuf{MemoryBuffer(char* begin, std::size_t size){setp(begin, begin + size);}};
+
+//creates the status file, sized for the histograms of stats, and writes a first snapshot
+StatusFile::StatusFile(const std::string& filename, const Stats& stats, long n_total){
+	std::ostringstream sizer; stats.write_state(sizer); std::size_t state_size = sizer.str().size();
+	map_size_ = sizeof(Header) + state_size;
+	
+	int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if((fd < 0) || (ftruncate(fd, map_size_) != 0)){std::cout << "\n\nCould not create the status file " << filename << ".\n\n"; exit(EXIT_FAILURE);}
+	void* map = mmap(NULL, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0); close(fd);
+	if(map == MAP_FAILED){std::cout << "\n\nCould not map the status file " << filename << ".\n\n"; exit(EXIT_FAILURE);}
+	
+	header_ = new(map) Header(); state_ = (char*)map + sizeof(Header);
+	header_->seq.store(0); header_->size = state_size;
+	update(stats, 0, n_total, 0.);
+	std::memcpy(header_->tag, status_tag, sizeof(status_tag)); //the tag goes in last, a reader never sees a half made file as valid
+}
+
+StatusFile::~StatusFile(){munmap((void*)header_, map_size_);}
+
+//rewrite the snapshot with the current histograms and counters
+void StatusFile::update(const Stats& stats, long n_done, long n_total, double elapsed, bool finished){
+	unsigned long long seq = header_->seq.load(std::memory_order_relaxed);
+	header_->seq.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	
+	header_->n_done = n_done; header_->n_total = n_total; header_->elapsed = elapsed; header_->finished = finished;
+	header_->rate = (elapsed > 0.) ? n_done/elapsed : 0.;
+	MemoryBuffer buffer(state_, header_->size); std::ostream out(&buffer); stats.write_state(out);
+	
+	header_->seq.store(seq + 2, std::memory_order_release);
+}
+
+//read the snapshot of a status file
+bool StatusFile::read(const std::string& filename, Snapshot& snap){
+	int fd = open(filename.c_str(), O_RDONLY); struct stat info;
+	if((fd < 0) || (fstat(fd, &info) != 0) || (info.st_size < (off_t)sizeof(Header))){
+		if(fd >= 0){close(fd);}
+		std::cout << "\n\nThe file " << filename << " is missing or is not a status file.\n\n"; return false;
+	}
+	std::size_t map_size = info.st_size;
+	void* map = mmap(NULL, map_size, PROT_READ, MAP_SHARED, fd, 0); close(fd);
+	if(map == MAP_FAILED){std::cout << "\n\nCould not map the status file " << filename << ".\n\n"; return false;}
+	const Header* header = (const Header*)map; const char* state = (const char*)map + sizeof(Header);
+	if((std::memcmp(header->tag, status_tag, sizeof(status_tag)) != 0) || (header->size != (long long)(map_size - sizeof(Header)))){
+		munmap(map, map_size); std::cout << "\n\nThe file " << filename << " is missing or is not a status file.\n\n"; return false;
+	}
+	
+	//copying until the sequence number is even and unchanged over the copy; an update only takes microseconds, so this settles quickly,
+	//unless the writer died in the middle of one, which leaves the number odd for good: then the reader gives up after read_timeout_ seconds
+	snap.state.resize(header->size); bool consistent = false;
+	auto tstart = std::chrono::steady_clock::now();
+	while(!consistent && (std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart).count() < read_timeout_)){
+		unsigned long long seq = header->seq.load(std::memory_order_acquire);
+		if(seq & 1ULL){std::this_thread::yield(); continue;}
+		snap.n_done = header->n_done; snap.n_total = header->n_total; snap.elapsed = header->elapsed; snap.rate = header->rate;
+		snap.finished = (header->finished != 0); std::memcpy(&snap.state[0], state, header->size);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		consistent = (header->seq.load(std::memory_order_relaxed) == seq);
+	}
+	munmap(map, map_size);
+	if(!consistent){
+		std::cout << "\n\nNo consistent snapshot of the status file " << filename << " could be read within " << read_timeout_ <<
+		  " s, the run writing it may have died during an update.\n\n";
+	}
+	
+return consistent;
+}
@@ -0,0 +1,78 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: TaskPool.cpp
+*
+* Description: Fork-join pool of worker threads, for splitting the work of a single event
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <iostream>
+#include "TaskPool.h"
+#include "Topology.h"
+
+//starting the workers, each waiting for the first job
+TaskPool::TaskPool(int n_threads, const std::vector<int>& cpu) : job_(0), next_(0), busy_(0), fn_(nullptr), n_tasks_(0), stop_(false) {
+	for(int iwork=1; iwork<n_threads; ++iwork){threads_.push_back(std::thread(&TaskPool::work, this, iwork, (iwork < cpu.size()) ? cpu[iwork] : -1));}
+}
+
+//stopping and joining the workers
+TaskPool::~TaskPool(){
+	{std::lock_guard<std::mutex> guard(lock_); stop_ = true; job_.fetch_add(1, std::memory_order_release);}
+	wake_.notify_all();
+	for(int ithr=0; ithr<threads_.size(); ++ithr){threads_[ithr].join();}
+}
+
+//run every task of a job, the caller taking tasks as well, and wait for the other workers to finish theirs
+void TaskPool::run(int n_tasks, const std::function<void(int, int)>& fn){
+	if(threads_.empty()){for(int itask=0; itask<n_tasks; ++itask){fn(itask, 0);} return;}
+	
+	fn_ = &fn; n_tasks_ = n_tasks; next_.store(0, std::memory_order_relaxed); busy_.store(threads_.size(), std::memory_order_relaxed);
+	{std::lock_guard<std::mutex> guard(lock_); job_.fetch_add(1, std::memory_order_release);}
+	wake_.notify_all();
+	take(0);
+	while(busy_.load(std::memory_order_acquire) > 0){std::this_thread::yield();}
+}
+
+//run tasks of the current job until none are left
+void TaskPool::take(int worker){
+	for(int itask=next_.fetch_add(1, std::memory_order_relaxed); itask<n_tasks_; itask=next_.fetch_add(1, std::memory_order_relaxed)){(*fn_)(itask, worker);}
+}
+
+//worker thread body: spin on the job counter for a while, then block until it changes
+void TaskPool::work(int worker, int cpu){
+	if((cpu >= 0) && !Topology::pin(cpu)){std::cout << "  Could not pin a task pool thread to CPU " << cpu << ", it is left unpinned.\n";}
+	
+	unsigned long long seen = 0;
+	while(true){
+		unsigned long long job = job_.load(std::memory_order_acquire);
+		for(int ispin=0; (job == seen) && (ispin < n_spin_); ++ispin){std::this_thread::yield(); job = job_.load(std::memory_order_acquire);}
+		if(job == seen){
+			std::unique_lock<std::mutex> guard(lock_);
+			wake_.wait(guard, [this, seen]{return job_.load(std::memory_order_acquire) != seen;});
+			job = job_.load(std::memory_order_acquire);
+		}
+		seen = job;
+		if(stop_){break;}
+		take(worker);
+		busy_.fetch_sub(1, std::memory_order_release);
+	}
+}
@@ -0,0 +1,87 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Topology.cpp
+*
+* Description: NUMA nodes (sockets) of the machine and their CPUs, for placing and pinning worker threads
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sched.h>
+#include "Topology.h"
+
+//reading the nodes and their CPUs, keeping only the CPUs in the affinity mask of this process
+Topology::Topology(){
+	cpu_set_t allowed; CPU_ZERO(&allowed);
+	bool have_mask = (sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+	
+	for(int inode=0; ; ++inode){
+		std::ifstream cpulist(("/sys/devices/system/node/node" + std::to_string(inode) + "/cpulist").c_str()); std::string list;
+		if(!std::getline(cpulist, list)){break;}
+		std::vector<int> all = parse_list(list); std::vector<int> cpus;
+		for(int icpu=0; icpu<all.size(); ++icpu){if(!have_mask || CPU_ISSET(all[icpu], &allowed)){cpus.push_back(all[icpu]);}}
+		if(!cpus.empty()){cpus_.push_back(cpus);}
+	}
+	
+	//no node information: a single node with every allowed CPU
+	if(cpus_.empty()){
+		std::vector<int> cpus;
+		for(int icpu=0; icpu<CPU_SETSIZE; ++icpu){if(have_mask && CPU_ISSET(icpu, &allowed)){cpus.push_back(icpu);}}
+		if(cpus.empty()){cpus.push_back(0);}
+		cpus_.push_back(cpus);
+	}
+}
+
+//parse a kernel cpu list, eg. "0-3,8-11"
+std::vector<int> Topology::parse_list(const std::string& list){
+	std::vector<int> cpus; std::stringstream liststream(list); std::string range;
+	while(std::getline(liststream, range, ',')){
+		if(range.empty()){continue;}
+		std::size_t dash = range.find('-');
+		int first = std::stoi(range.substr(0, dash)); int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash+1));
+		for(int icpu=first; icpu<=last; ++icpu){cpus.push_back(icpu);}
+	}
+	
+return cpus;
+}
+
+//CPU and node for worker ithr; with more workers than CPUs the placement wraps around
+void Topology::place(int ithr, int mode, int& cpu, int& node) const {
+	if(mode == 2){
+		node = ithr % cpus_.size(); int slot = ithr / cpus_.size();
+		cpu = cpus_[node][slot % cpus_[node].size()];
+		return;
+	}
+	int n_cpus = 0; for(int inode=0; inode<cpus_.size(); ++inode){n_cpus += cpus_[inode].size();}
+	int slot = ithr % n_cpus;
+	for(node=0; slot >= cpus_[node].size(); ++node){slot -= cpus_[node].size();}
+	cpu = cpus_[node][slot];
+}
+
+//pin the calling thread to a CPU
+bool Topology::pin(int cpu){
+	cpu_set_t set; CPU_ZERO(&set); CPU_SET(cpu, &set);
+	
+return (sched_setaffinity(0, sizeof(set), &set) == 0);
+}
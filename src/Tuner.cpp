@@ -0,0 +1,157 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Tuner.cpp
+*
+* Description: Picks the fastest collision kernel and hard-core check for a configuration, by benchmarking or from a cache file
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include "Tuner.h"
+
+//picks the strategy and hard-core checks for the configuration in settings
+Tuner::Tuner(const Settings& settings){
+	//the hard-core check only matters for heavy nuclei, and the sorted kernel only when one of the nuclei is heavy (and not in hotspot mode)
+	bool heavy_a = (settings.nuctypea == 2); bool heavy_b = (settings.nuctypeb == 2); hotspots_ = (settings.hotspots > 0);
+	strategy_ = ((heavy_a || heavy_b) && !hotspots_) ? settings.coll_kernel : 0;
+	hardcore_a_ = heavy_a ? settings.hardcore : 0; hardcore_b_ = heavy_b ? settings.hardcore : 0;
+	source_ = "set";
+	if((strategy_ >= 0) && (hardcore_a_ >= 0) && (hardcore_b_ >= 0)){return;}
+	
+	//the tune file is keyed by the system (nuclei, collision distance, precision) and the CPU model
+	std::stringstream system;
+	system << settings.nuctypea << "/" << settings.num_pro_a << "/" << settings.num_neu_a << "+" << settings.nuctypeb << "/" << settings.num_pro_b << "/" <<
+	  settings.num_neu_b << " colldist=" << settings.coll_dist << (settings.single_prec ? " float" : " double") << (hotspots_ ? " hotspots" : "") <<
+	  ((settings.profile > 0) ? " profile=" + std::to_string(settings.profile) + "/" + std::to_string(settings.prof_amp) : "") <<
+	  ((settings.needed_observables() != Event::OBS_ALL) ? " obs=" + std::to_string(settings.needed_observables()) : "");
+	system_ = system.str();
+	
+	//anything not set is taken from the tune file, or benchmarked and then cached; without a tune file no file is read or written
+	bool cache = !settings.tunefile.empty(); if(cache){cpu_ = cpu_model();}
+	int set_strategy = strategy_; int set_hardcore_a = hardcore_a_; int set_hardcore_b = hardcore_b_;
+	if(cache && read(settings.tunefile)){source_ = "cached";}
+	else{
+		strategy_ = ((heavy_a || heavy_b) && !hotspots_) ? bench_collide(settings) : 0;
+		hardcore_a_ = heavy_a ? bench_fill(settings.nuctypea, settings.num_pro_a, settings.num_neu_a) : 0;
+		//a symmetric system has the same nucleus twice, so its benchmark is reused
+		bool same = heavy_a && (settings.nuctypeb == settings.nuctypea) && (settings.num_pro_b == settings.num_pro_a) && (settings.num_neu_b == settings.num_neu_a);
+		hardcore_b_ = heavy_b ? (same ? hardcore_a_ : bench_fill(settings.nuctypeb, settings.num_pro_b, settings.num_neu_b)) : 0;
+		source_ = "benchmarked";
+		if(cache){write(settings.tunefile);}
+	}
+	if(set_strategy >= 0){strategy_ = set_strategy;}
+	if(set_hardcore_a >= 0){hardcore_a_ = set_hardcore_a;} if(set_hardcore_b >= 0){hardcore_b_ = set_hardcore_b;}
+}
+
+//one line description of the choice
+std::string Tuner::describe(){
+	std::string out = "Collision kernel: " + std::string(hotspots_ ? "hotspots" : (strategy_ == 1) ? "sorted" : "all pairs") + ", hard-core check: A " +
+	  (hardcore_a_ == 1 ? "cells" : "scan") + ", B " + (hardcore_b_ == 1 ? "cells" : "scan") + " (" + source_ + ")";
+	
+return out;
+}
+
+//CPU model name from /proc/cpuinfo
+std::string Tuner::cpu_model(){
+	std::ifstream cpuinfo("/proc/cpuinfo"); std::string line;
+	while(std::getline(cpuinfo, line)){
+		if(line.compare(0, 10, "model name") != 0){continue;}
+		std::size_t colon = line.find(':'); if(colon == std::string::npos){continue;}
+		std::size_t start = line.find_first_not_of(" \t", colon+1);
+		if(start != std::string::npos){return line.substr(start);}
+	}
+	
+return "unknown";
+}
+
+//the tune file has one tab separated line per entry: system, CPU model, then the strategy and the hard-core checks of nucleus a and b
+bool Tuner::read(const std::string& tunefile){
+	std::ifstream tune(tunefile.c_str()); std::string line;
+	while(std::getline(tune, line)){
+		if((line.empty()) || (line.front() == '#')){continue;}
+		std::size_t tab1 = line.find('\t'); std::size_t tab2 = (tab1 == std::string::npos) ? tab1 : line.find('\t', tab1+1);
+		if(tab2 == std::string::npos){continue;}
+		if((line.substr(0, tab1) != system_) || (line.substr(tab1+1, tab2-tab1-1) != cpu_)){continue;}
+		std::stringstream vals(line.substr(tab2+1)); int strategy_in = 0; int hardcore_a_in = 0; int hardcore_b_in = 0;
+		if(!(vals >> strategy_in >> hardcore_a_in >> hardcore_b_in)){continue;}
+		strategy_ = strategy_in; hardcore_a_ = hardcore_a_in; hardcore_b_ = hardcore_b_in;
+		return true;
+	}
+	
+return false;
+}
+
+//replace (or add) the entry for this system and CPU; a tune file that cannot be written only means the next run benchmarks again
+void Tuner::write(const std::string& tunefile){
+	std::vector<std::string> lines; std::string line; std::string key = system_ + "\t" + cpu_ + "\t";
+	std::ifstream tune_in(tunefile.c_str());
+	while(std::getline(tune_in, line)){if(line.compare(0, key.size(), key) != 0){lines.push_back(line);}}
+	tune_in.close();
+	if(lines.empty()){lines.push_back("#system\tCPU model\tkernel (0=all pairs, 1=sorted) hard-core A, B (0=scan, 1=cells)");}
+	
+	std::ofstream tune_out(tunefile.c_str());
+	for(int iline=0; iline<lines.size(); ++iline){tune_out << lines[iline] << "\n";}
+	tune_out << key << strategy_ << " " << hardcore_a_ << " " << hardcore_b_ << "\n";
+}
+
+//fastest hard-core check for a nucleus, timing fills with each check
+int Tuner::bench_fill(int type, int npro, int nneu){
+	Nucleus nuc(type, npro, nneu);
+	double best[2] = {1.e300, 1.e300};
+	for(int iround=0; iround<n_rounds_; ++iround){
+		for(int mode=0; mode<2; ++mode){
+			nuc.hardcore(mode);
+			std::chrono::steady_clock::time_point tstart = std::chrono::steady_clock::now();
+			for(int iwarm=0; iwarm<n_warm_; ++iwarm){nuc.fill();}
+			double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart).count();
+			if(t < best[mode]){best[mode] = t;}
+		}
+	}
+	
+return (best[1] < (1. - margin_)*best[0]) ? 1 : 0;
+}
+
+//fastest collision kernel strategy for a configuration, timing collisions of the same nuclei with each strategy
+int Tuner::bench_collide(const Settings& settings){
+	Event event(settings.nuctypea, settings.num_pro_a, settings.num_neu_a, settings.nuctypeb, settings.num_pro_b, settings.num_neu_b, settings.coll_dist);
+	event.single(settings.single_prec); event.profile(settings.profile, settings.prof_amp); event.observables(settings.needed_observables());
+	double best[2] = {1.e300, 1.e300};
+	for(int iround=0; iround<n_rounds_; ++iround){
+		double t[2] = {0., 0.};
+		for(int iwarm=0; iwarm<n_warm_; ++iwarm){
+			event.nuc_a().fill(); event.nuc_b().fill();
+			for(int strategy=0; strategy<2; ++strategy){
+				event.strategy(strategy);
+				std::chrono::steady_clock::time_point tstart = std::chrono::steady_clock::now();
+				for(int icoll=0; icoll<n_coll_; ++icoll){event.collide(event.nuc_a(), event.nuc_b());}
+				t[strategy] += std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart).count();
+			}
+		}
+		for(int strategy=0; strategy<2; ++strategy){if(t[strategy] < best[strategy]){best[strategy] = t[strategy];}}
+	}
+	
+return (best[1] < (1. - margin_)*best[0]) ? 1 : 0;
+}
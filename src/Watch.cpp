@@ -0,0 +1,77 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: Watch.cpp
+*
+* Description: Reader of the live status file of a running Collider.out, prints or dumps snapshots without pausing the run
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include "Stats.h"
+#include "StatusFile.h"
+
+//printing the counters of a snapshot, and the N_coll histogram entries
+void report(const StatusFile::Snapshot& snap, Stats& stats){
+	std::cout << "  " << snap.n_done << " out of " << snap.n_total << " Events generated   " <<
+	  ((snap.n_total > 0) ? ((double)snap.n_done/snap.n_total)*100. : 0.) << "% finished" << (snap.finished ? " (run over)" : "") << "\n";
+	std::cout << "  Elapsed: " << snap.elapsed/60. << " minutes, Avg. # events / sec: " << snap.rate << "\n";
+	std::cout << "  N_coll, Entries:";
+	for(int ibin=0; ibin<stats.n_coll().n_bins(); ++ibin){std::cout << " " << stats.n_coll().mean_bin(ibin) << ":" << stats.n_coll().val_bin(ibin);}
+	std::cout << "\n\n";
+}
+
+int main(int argc, char* argv[]){
+	//reading command line arguments: the switches first, then the status file
+	std::string outfile = ""; std::string statefile = ""; double every = 0.; std::string statusfile = "";
+	for(int i=1; i<argc; ++i){
+		std::string argument = argv[i];
+		if((argument == "-outfile") && (i+1 < argc)){outfile = argv[++i];}
+		else if((argument == "-statefile") && (i+1 < argc)){statefile = argv[++i];}
+		else if((argument == "-every") && (i+1 < argc)){every = std::stod(argv[++i]);}
+		else if((!argument.empty() && (argument[0] == '-')) || !statusfile.empty()){statusfile = ""; break;}
+		else{statusfile = argument;}
+	}
+	if(statusfile.empty()){
+		std::cout << " Usage: ./Watch.out [-outfile <file>] [-statefile <file>] [-every <seconds>] <status file>\n";
+		std::cout << " Prints the progress and N_coll histogram of a run writing the given status file (Collider.out -statusfile), without pausing it.\n";
+		std::cout << " Switch: '-outfile' to also write the histograms of the snapshot, in the same format as the output file. Default: '' (none)\n";
+		std::cout << " Switch: '-statefile' to also write the binary state of the snapshot, so it can be merged with Merge.out. Default: '' (none)\n";
+		std::cout << " Switch: '-every' to keep printing a snapshot every given number of seconds until the run is over. Default: 0 (once)\n\n";
+		return 0;
+	}
+	
+	//reading snapshots, repeating while the run goes on if asked to
+	StatusFile::Snapshot snap;
+	do{
+		if(!StatusFile::read(statusfile, snap)){exit(EXIT_FAILURE);}
+		std::istringstream state(snap.state); Stats stats = Stats::read_state(state, statusfile);
+		report(snap, stats);
+		if(!outfile.empty()){stats.write(outfile);} if(!statefile.empty()){stats.write_state(statefile);}
+		if((every > 0.) && !snap.finished){std::this_thread::sleep_for(std::chrono::duration<double>(every));}
+	}while((every > 0.) && !snap.finished);
+	
+return 0;
+}
@@ -0,0 +1,119 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: collider_c.cpp
+*
+* Description: C interface of the embeddable event generator, for linking libcollider from C or other languages
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes here
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "collider_c.h"
+#include "Generator.h"
+
+//the C handle is the C++ generator
+struct collider_gen{
+	Generator gen;
+	collider_gen(const Settings& settings) : gen(settings) {}
+};
+
+//copying the observables of the last event
+static void copy_event(Generator& gen, collider_event* out){
+	Event& event = gen.event();
+	out->index = gen.i_eve() - 1; out->n_coll = event.n_coll(); out->n_part = event.n_part(); out->area = event.area();
+	out->b_x = event.b_x(); out->b_y = event.b_y(); out->part_cx = event.part_cx(); out->part_cy = event.part_cy();
+	for(int n=0; n<7; ++n){out->ecc[n] = (n >= 2 && event.ecc()) ? event.ecc(n) : 0.; out->psi[n] = (n >= 2 && event.ecc()) ? event.psi(n) : 0.;}
+}
+
+//fills config with the default settings
+void collider_config_default(collider_config* config){
+	Settings settings;
+	config->n_eve = settings.n_eve; config->coll_dist = settings.coll_dist;
+	config->nuc_a = settings.nuctypea; config->npro_a = settings.num_pro_a; config->nneu_a = settings.num_neu_a;
+	config->nuc_b = settings.nuctypeb; config->npro_b = settings.num_pro_b; config->nneu_b = settings.num_neu_b;
+	config->single_prec = settings.single_prec; config->ecc = settings.ecc; config->seed = settings.seed;
+	config->shard_i = settings.shard_i; config->shard_n = settings.shard_n; config->extra = NULL;
+}
+
+//makes a generator for the configuration, or returns NULL with a message if the configuration is bad
+//nothing may exit or throw past this point, since the host process would go down with it
+collider_gen* collider_new(const collider_config* config){
+	try{
+		Settings settings;
+		settings.n_eve = config->n_eve; settings.coll_dist = config->coll_dist;
+		settings.nuctypea = config->nuc_a; settings.num_pro_a = config->npro_a; settings.num_neu_a = config->nneu_a;
+		settings.nuctypeb = config->nuc_b; settings.num_pro_b = config->npro_b; settings.num_neu_b = config->nneu_b;
+		settings.single_prec = (config->single_prec != 0); settings.ecc = (config->ecc != 0); settings.seed = config->seed;
+		settings.shard_i = config->shard_i; settings.shard_n = config->shard_n;
+	
+		//further settings through the common tag parser
+		if(config->extra != NULL){
+			std::stringstream extra(config->extra); std::string tag; std::string val;
+			while(extra >> tag >> val){
+				if(!settings.set(tag, val)){std::cout << " Tag " << tag << " given to collider_new was not recognized.\n"; return NULL;}
+			}
+		}
+	
+		//the checks Collider.out exits on; a precision target needs histograms, which the C interface does not keep
+		std::string problem = Generator::check(settings);
+		if(problem.empty() && (settings.target > 0.)){problem = "A precision target is not available through the C interface.";}
+		if(!problem.empty()){std::cout << " " << problem << " (collider_new)\n"; return NULL;}
+	
+		return new collider_gen(settings);
+	}
+	//bad values in extra (std::stoi and friends throw), or running out of memory
+	catch(const std::exception& e){std::cout << " The configuration given to collider_new could not be used: " << e.what() << "\n"; return NULL;}
+}
+
+void collider_free(collider_gen* gen){delete gen;}
+
+//generates the next event into event
+int collider_next(collider_gen* gen, collider_event* event){
+	if(!gen->gen.next()){return 0;}
+	if(event != NULL){copy_event(gen->gen, event);}
+	
+return 1;
+}
+
+//generates the remaining events, calling callback on each
+int collider_run(collider_gen* gen, collider_callback callback, void* user){
+	collider_event event;
+	
+return gen->gen.run([&](Event&){copy_event(gen->gen, &event); return callback(&event, gen, user) != 0;});
+}
+
+//number of nucleons of nucleus a or b
+int collider_n_nucleons(collider_gen* gen, int side){
+return (side == 0) ? gen->gen.event().nuc_a().size() : gen->gen.event().nuc_b().size();
+}
+
+//positions and binary collision counts of the nucleons of nucleus a or b of the last event
+int collider_nucleons(collider_gen* gen, int side, double* x, double* y, double* z, int* hits){
+	Event& event = gen->gen.event(); Nucleus& nuc = (side == 0) ? event.nuc_a() : event.nuc_b();
+	for(int i=0; i<nuc.size(); ++i){
+		if(x != NULL){x[i] = nuc[i].x();} if(y != NULL){y[i] = nuc[i].y();} if(z != NULL){z[i] = nuc[i].z();}
+		if(hits != NULL){hits[i] = (side == 0) ? event.hits_a(i) : event.hits_b(i);}
+	}
+	
+return nuc.size();
+}
@@ -0,0 +1,292 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: equiv.cpp
+*
+* Description: Statistical equivalence test of the optimised samplers and collision kernels against a reference implementation
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include "Event.h"
+#include "Nucleus.h"
+
+//reference implementation: the original nucleus samplers (mt19937_64, per-call distributions, acos/sin/cos/pow) and the original all-pairs
+//double precision collision with the impact parameter bounded by the largest transverse distance between the nuclei
+//it is kept separate from the code being tested on purpose, so an optimisation cannot change both sides of the comparison
+class RefNucleus{
+  public:
+	std::vector<double> x, y, z; int type, npro, nneu;
+	std::mt19937_64 eng;
+	RefNucleus(int type_in, int npro_in, int nneu_in, unsigned long long seed) : type(type_in), npro(npro_in), nneu(nneu_in), eng(seed) {}
+	double ran() {std::uniform_real_distribution<double> uniran(0.,1.); return uniran(eng);}
+	
+	double mindist(double x_in, double y_in, double z_in){
+		double dist_out = 9.e100;
+		for(int i=0; i<x.size(); i++){
+			double dist = (x_in - x[i])*(x_in - x[i]) + (y_in - y[i])*(y_in - y[i]) + (z_in - z[i])*(z_in - z[i]);
+			if(dist < dist_out){dist_out = dist;}
+		}
+		return std::sqrt(dist_out);
+	}
+	
+	void fill(){
+		const double pi = 3.14159265358979; const double e = 2.71828182845904523;
+		x.clear(); y.clear(); z.clear();
+		if(type == 0){x.push_back(0.); y.push_back(0.); z.push_back(0.); return;}
+		const double WSR = 1.25*pow(npro + nneu, (1./3.)); const double WSa = 0.535; const double RA = 3.*WSR;
+		const double ha = 0.228; const double hb = 1.18; const double Rd = 3.*7.3;
+		while(x.size() < npro + nneu){
+			double r = (type == 1) ? Rd*pow(ran(), 1./3.) : (5./3.)*RA*pow(ran(), 1./3.);
+			double th = acos(2.*ran() - 1.);
+			double ph = ran()*2.*pi;
+			double x_val = r*sin(th)*cos(ph); double y_val = r*sin(th)*sin(ph); double z_val = r*cos(th);
+			double Psi = (type == 1) ? pow(r, -2.)*pow(pow(e, -ha*r) - pow(e, -hb*r), 2.) : 1./(1. + pow(e, (r - WSR)/WSa));
+			double k = (type == 1) ? 0.97*ran() : ran();
+			if(Psi < k){continue;}
+			if((x.size() > 0) && (mindist(x_val, y_val, z_val) < 1.)){continue;}
+			x.push_back(x_val); y.push_back(y_val); z.push_back(z_val);
+		}
+		double cx = 0., cy = 0., cz = 0.;
+		for(int i=0; i<x.size(); i++){cx += x[i]; cy += y[i]; cz += z[i];}
+		for(int i=0; i<x.size(); i++){x[i] -= cx/x.size(); y[i] -= cy/x.size(); z[i] -= cz/x.size();}
+	}
+};
+
+//reference event, returns n_coll, n_part and area through the arguments
+//profile 1 (gray disk) and 2 (Gaussian) are the plain per-pair formulas with std::exp and a draw for every pair, with no cutoff
+void ref_event(RefNucleus& nuc_a, RefNucleus& nuc_b, std::mt19937_64& eng, double coll_dist, int& n_coll, int& n_part, double& area,
+  int profile = 0, double amp = 1.){
+	std::uniform_real_distribution<double> uniran(0.,1.);
+	nuc_a.fill(); nuc_b.fill();
+	int n_a = nuc_a.x.size(); int n_b = nuc_b.x.size();
+	double r_max = 0.;
+	for(int ia=0; ia<n_a; ia++){for(int ib=0; ib<n_b; ib++){
+		r_max = std::max(r_max, (nuc_a.x[ia] - nuc_b.x[ib])*(nuc_a.x[ia] - nuc_b.x[ib]) + (nuc_a.y[ia] - nuc_b.y[ib])*(nuc_a.y[ia] - nuc_b.y[ib]));
+	}}
+	r_max = std::sqrt(r_max) + ((profile == 0) ? coll_dist : 8.*coll_dist/std::sqrt(amp)); //past 8 coll_dist/sqrt(amp) the Gaussian is < 1e-20
+	
+	n_coll = 0;
+	while(n_coll == 0){
+		double r_samp = sqrt(r_max*r_max*uniran(eng)); double th = uniran(eng)*2.*3.14159265358979;
+		double offset_x = r_samp*cos(th); double offset_y = r_samp*sin(th);
+		std::vector<int> part_a(n_a, 0); std::vector<int> part_b(n_b, 0); area = 0.;
+		for(int ia=0; ia<n_a; ia++){for(int ib=0; ib<n_b; ib++){
+			double dist2 = (nuc_a.x[ia] - nuc_b.x[ib] - offset_x)*(nuc_a.x[ia] - nuc_b.x[ib] - offset_x) +
+			  (nuc_a.y[ia] - nuc_b.y[ib] - offset_y)*(nuc_a.y[ia] - nuc_b.y[ib] - offset_y);
+			bool hit = (dist2 <= coll_dist*coll_dist);
+			if(profile == 1){hit = (uniran(eng) < amp) && (dist2 <= coll_dist*coll_dist/amp);}
+			if(profile == 2){hit = (uniran(eng) < amp*std::exp(-amp*dist2/(coll_dist*coll_dist)));}
+			if(hit){
+				++n_coll; part_a[ia] = 1; part_b[ib] = 1;
+				double dist = sqrt(dist2); area += (dist < 2.*coll_dist) ? 0.5*dist*sqrt(4.*coll_dist*coll_dist - dist*dist) : 0.;
+			}
+		}}
+		n_part = 0;
+		for(int ia=0; ia<n_a; ia++){n_part += part_a[ia];} for(int ib=0; ib<n_b; ib++){n_part += part_b[ib];}
+	}
+}
+
+//regularized upper incomplete gamma function Q(a,x), by series for x < a+1 and by continued fraction otherwise
+double gamma_q(double a, double x){
+	if(x <= 0.){return 1.;}
+	double gln = std::lgamma(a);
+	if(x < a + 1.){
+		double ap = a; double sum = 1./a; double del = sum;
+		for(int n=0; n<1000; n++){ap += 1.; del *= x/ap; sum += del; if(std::abs(del) < std::abs(sum)*1.e-15){break;}}
+		return 1. - sum*std::exp(-x + a*std::log(x) - gln);
+	}
+	double b = x + 1. - a; double c = 1./1.e-300; double d = 1./b; double h = d;
+	for(int i=1; i<1000; i++){
+		double an = -i*(i - a); b += 2.;
+		d = an*d + b; if(std::abs(d) < 1.e-300){d = 1.e-300;}
+		c = b + an/c; if(std::abs(c) < 1.e-300){c = 1.e-300;}
+		d = 1./d; double del = d*c; h *= del;
+		if(std::abs(del - 1.) < 1.e-15){break;}
+	}
+	return std::exp(-x + a*std::log(x) - gln)*h;
+}
+
+//two-sample Kolmogorov-Smirnov test, returns the p-value (asymptotic distribution, conservative for discrete values)
+double ks_test(std::vector<double> s1, std::vector<double> s2){
+	std::sort(s1.begin(), s1.end()); std::sort(s2.begin(), s2.end());
+	double n1 = s1.size(); double n2 = s2.size(); double d = 0.;
+	for(int i1=0, i2=0; (i1 < s1.size()) && (i2 < s2.size());){
+		double v = std::min(s1[i1], s2[i2]);
+		while((i1 < s1.size()) && (s1[i1] == v)){i1++;} while((i2 < s2.size()) && (s2[i2] == v)){i2++;}
+		d = std::max(d, std::abs(i1/n1 - i2/n2));
+	}
+	double ne = std::sqrt(n1*n2/(n1 + n2)); double lambda = (ne + 0.12 + 0.11/ne)*d;
+	double p = 0.; double sign = 1.;
+	for(int j=1; j<=100; j++){double term = 2.*sign*std::exp(-2.*j*j*lambda*lambda); p += term; sign = -sign; if(std::abs(term) < 1.e-12){break;}}
+	
+return (lambda < 0.2) ? 1. : std::min(std::max(p, 0.), 1.);
+}
+
+//two-sample chi^2 test on n_bins bins with (about) equal counts of the pooled sample, returns the p-value
+double chi2_test(const std::vector<double>& s1, const std::vector<double>& s2, int n_bins){
+	std::vector<double> pooled(s1); pooled.insert(pooled.end(), s2.begin(), s2.end()); std::sort(pooled.begin(), pooled.end());
+	std::vector<double> edges;
+	for(int ibin=1; ibin<n_bins; ibin++){
+		double edge = pooled[(pooled.size()*ibin)/n_bins];
+		if(edges.empty() || (edge > edges.back())){edges.push_back(edge);}
+	}
+	std::vector<double> c1(edges.size()+1, 0.); std::vector<double> c2(edges.size()+1, 0.);
+	for(int i=0; i<s1.size(); i++){c1[std::upper_bound(edges.begin(), edges.end(), s1[i]) - edges.begin()] += 1.;}
+	for(int i=0; i<s2.size(); i++){c2[std::upper_bound(edges.begin(), edges.end(), s2[i]) - edges.begin()] += 1.;}
+	double n1 = s1.size(); double n2 = s2.size(); double chi2 = 0.; int dof = -1;
+	for(int ibin=0; ibin<c1.size(); ibin++){
+		if(c1[ibin] + c2[ibin] == 0.){continue;}
+		double diff = std::sqrt(n2/n1)*c1[ibin] - std::sqrt(n1/n2)*c2[ibin];
+		chi2 += diff*diff/(c1[ibin] + c2[ibin]); dof++;
+	}
+	
+return (dof > 0) ? gamma_q(0.5*dof, 0.5*chi2) : 1.;
+}
+
+//compares a variant sample to the reference sample with both tests, printing the p-values; returns false if either is below its threshold
+bool compare(const std::string& name, const std::vector<double>& ref, const std::vector<double>& var, double p_ks, double p_chi2, int n_bins){
+	double pk = ks_test(ref, var); double pc = chi2_test(ref, var, n_bins);
+	bool pass = (pk >= p_ks) && (pc >= p_chi2);
+	std::cout << "  " << std::left << std::setw(44) << name << " KS p = " << std::setw(12) << pk << " chi2 p = " << std::setw(12) << pc <<
+	  (pass ? "" : "  DRIFT") << "\n";
+	
+return pass;
+}
+
+int main(int argc, char* argv[]){
+	//settings: events per sample, nuclei per radial density sample, p-value thresholds, chi^2 bins, and the base seed
+	//the seeds are fixed so the test is reproducible; the thresholds are low enough that the many comparisons do not fail by chance
+	int n_eve = 1000; int n_nuc = 200; double p_ks = 1.e-4; double p_chi2 = 1.e-4; int n_bins = 20; unsigned long long seed = 2020;
+	for(int i=1; i+1<argc; i+=2){
+		std::string arg = argv[i];
+		if(     arg == "-n"    ){n_eve  = std::stoi(argv[i+1]);}
+		else if(arg == "-nnuc" ){n_nuc  = std::stoi(argv[i+1]);}
+		else if(arg == "-pks"  ){p_ks   = std::stod(argv[i+1]);}
+		else if(arg == "-pchi2"){p_chi2 = std::stod(argv[i+1]);}
+		else if(arg == "-bins" ){n_bins = std::stoi(argv[i+1]);}
+		else if(arg == "-seed" ){seed   = std::stoull(argv[i+1]);}
+		else{std::cout << " Usage: equiv.out [-n events] [-nnuc nuclei] [-pks p] [-pchi2 p] [-bins n] [-seed s]\n"; return 1;}
+	}
+	std::cout << "\n Statistical equivalence against the reference implementation: " << n_eve << " events and " << n_nuc <<
+	  " nuclei per sample, failing below KS p = " << p_ks << " or chi2 p = " << p_chi2 << " (" << n_bins << " bins)\n";
+	bool pass = true;
+	
+	//radial density of the nucleons, for each nucleus sampler and hard-core check
+	struct Species{const char* name; int type; int npro; int nneu;};
+	Species species[3] = {{"d", 1, 1, 1}, {"Au", 2, 79, 118}, {"Pb", 2, 82, 126}};
+	for(int ispec=0; ispec<3; ispec++){
+		Species& s = species[ispec];
+		std::cout << "\n Radial density, " << s.name << ":\n";
+		//both deuteron nucleons sit at the same radius after centering, so only the first is taken (a repeated value would skew the tests)
+		int n_fill = (s.type == 1) ? 100*n_nuc : n_nuc; int n_take = (s.type == 1) ? 1 : s.npro + s.nneu;
+		RefNucleus ref(s.type, s.npro, s.nneu, seed + ispec); std::vector<double> r_ref;
+		for(int ifill=0; ifill<n_fill; ifill++){
+			ref.fill();
+			for(int i=0; i<n_take; i++){r_ref.push_back(std::sqrt(ref.x[i]*ref.x[i] + ref.y[i]*ref.y[i] + ref.z[i]*ref.z[i]));}
+		}
+		for(int hc=0; hc<((s.type == 2) ? 2 : 1); hc++){
+			Nucleus nuc(s.type, s.npro, s.nneu); nuc.seed(seed + 100 + ispec); nuc.hardcore(hc); std::vector<double> r_var;
+			for(int ifill=0; ifill<n_fill; ifill++){
+				nuc.fill();
+				for(int i=0; i<n_take; i++){r_var.push_back(std::sqrt(nuc[i].x()*nuc[i].x() + nuc[i].y()*nuc[i].y() + double(nuc[i].z())*nuc[i].z()));}
+			}
+			pass &= compare(std::string("Nucleus, hard-core ") + (hc ? "cells" : "scan"), r_ref, r_var, p_ks, p_chi2, n_bins);
+		}
+	}
+	
+	//N_coll, N_part and area for each collision system, against every precision, kernel strategy and hard-core check
+	struct System{const char* name; Species a; Species b; double coll_dist;};
+	System systems[3] = {{"p+Pb", {"p", 0, 1, 0}, species[2], 1.}, {"d+Au", species[0], species[1], 1.}, {"Pb+Pb", species[2], species[2], 1.}};
+	for(int isys=0; isys<3; isys++){
+		System& sys = systems[isys];
+		std::cout << "\n " << sys.name << ":\n";
+		RefNucleus ref_a(sys.a.type, sys.a.npro, sys.a.nneu, seed + 10 + isys); RefNucleus ref_b(sys.b.type, sys.b.npro, sys.b.nneu, seed + 20 + isys);
+		std::mt19937_64 eng(seed + 30 + isys);
+		std::vector<double> ref_coll, ref_part, ref_area;
+		for(int i_eve=0; i_eve<n_eve; i_eve++){
+			int n_coll = 0; int n_part = 0; double area = 0.;
+			ref_event(ref_a, ref_b, eng, sys.coll_dist, n_coll, n_part, area);
+			ref_coll.push_back(n_coll); ref_part.push_back(n_part); ref_area.push_back(area);
+		}
+		
+		int n_hc = (sys.a.type == 2 || sys.b.type == 2) ? 2 : 1;
+		for(int prec=0; prec<2; prec++){for(int strategy=0; strategy<2; strategy++){for(int hc=0; hc<n_hc; hc++){
+			Event event(sys.a.type, sys.a.npro, sys.a.nneu, sys.b.type, sys.b.npro, sys.b.nneu, sys.coll_dist);
+			event.single(prec == 1); event.strategy(strategy); event.nuc_a().hardcore(hc); event.nuc_b().hardcore(hc);
+			event.seed(seed + 1000 + 10*isys + 4*prec + 2*strategy + hc);
+			std::vector<double> var_coll, var_part, var_area;
+			for(int i_eve=0; i_eve<n_eve; i_eve++){event.gen(); var_coll.push_back(event.n_coll()); var_part.push_back(event.n_part()); var_area.push_back(event.area());}
+			std::string name = std::string(prec ? "float" : "double") + ", " + (strategy ? "sorted" : "all pairs") + ", " + (hc ? "cells" : "scan");
+			pass &= compare(name + ": N_coll", ref_coll, var_coll, p_ks, p_chi2, n_bins);
+			pass &= compare(name + ": N_part", ref_part, var_part, p_ks, p_chi2, n_bins);
+			pass &= compare(name + ": area", ref_area, var_area, p_ks, p_chi2, n_bins);
+		}}}
+	}
+	
+	//gray disk and Gaussian collision profiles for the light-heavy systems, against every precision and kernel strategy
+	for(int isys=0; isys<2; isys++){for(int profile=1; profile<=2; profile++){
+		System& sys = systems[isys]; double amp = 0.6;
+		std::cout << "\n " << sys.name << ", " << ((profile == 1) ? "gray disk" : "Gaussian") << " profile:\n";
+		RefNucleus ref_a(sys.a.type, sys.a.npro, sys.a.nneu, seed + 40 + isys); RefNucleus ref_b(sys.b.type, sys.b.npro, sys.b.nneu, seed + 50 + isys);
+		std::mt19937_64 eng(seed + 60 + 2*isys + profile);
+		std::vector<double> ref_coll, ref_part, ref_area;
+		for(int i_eve=0; i_eve<n_eve; i_eve++){
+			int n_coll = 0; int n_part = 0; double area = 0.;
+			ref_event(ref_a, ref_b, eng, sys.coll_dist, n_coll, n_part, area, profile, amp);
+			ref_coll.push_back(n_coll); ref_part.push_back(n_part); ref_area.push_back(area);
+		}
+		
+		for(int prec=0; prec<2; prec++){for(int strategy=0; strategy<2; strategy++){
+			Event event(sys.a.type, sys.a.npro, sys.a.nneu, sys.b.type, sys.b.npro, sys.b.nneu, sys.coll_dist);
+			event.single(prec == 1); event.strategy(strategy); event.profile(profile, amp);
+			event.seed(seed + 2000 + 20*isys + 10*profile + 2*prec + strategy);
+			std::vector<double> var_coll, var_part, var_area;
+			for(int i_eve=0; i_eve<n_eve; i_eve++){event.gen(); var_coll.push_back(event.n_coll()); var_part.push_back(event.n_part()); var_area.push_back(event.area());}
+			std::string name = std::string(prec ? "float" : "double") + ", " + (strategy ? "sorted" : "all pairs");
+			pass &= compare(name + ": N_coll", ref_coll, var_coll, p_ks, p_chi2, n_bins);
+			pass &= compare(name + ": N_part", ref_part, var_part, p_ks, p_chi2, n_bins);
+			pass &= compare(name + ": area", ref_area, var_area, p_ks, p_chi2, n_bins);
+		}}
+		
+		//from the same seed, both strategies make the same events (the draws are keyed to the nucleons of each pair, not the pair order)
+		Event all(sys.a.type, sys.a.npro, sys.a.nneu, sys.b.type, sys.b.npro, sys.b.nneu, sys.coll_dist); Event sorted = all;
+		all.strategy(0); sorted.strategy(1); all.profile(profile, amp); sorted.profile(profile, amp);
+		all.seed(seed + 3000 + 10*isys + profile); sorted.seed(seed + 3000 + 10*isys + profile);
+		int n_diff = 0;
+		for(int i_eve=0; i_eve<n_eve; i_eve++){all.gen(); sorted.gen(); n_diff += (all.n_coll() != sorted.n_coll()) || (all.n_part() != sorted.n_part());}
+		std::cout << "  all pairs and sorted from the same seed: " << n_diff << " of " << n_eve << " events differ " << ((n_diff == 0) ? "(pass)" : "(FAIL)") << "\n";
+		pass &= (n_diff == 0);
+	}}
+	
+	if(!pass){std::cout << "\n\n FAILURE: an optimised path drifted from the reference implementation.\n\n"; return 1;}
+	
+	//Success!
+	std::cout << "\n\n SUCCESS: Statistical equivalence test passed.\n\n";
+	
+return 0;
+}
@@ -75,6 +75,32 @@ int main(){
 	assert( is_close(vec.y(), val2, error) );
 	assert( is_close(vec.z(), val3, error) );
 	
+	//checking the Lorentz boosts: a random velocity with |v| < 0.9
+	double vx = 0.5*(ran() - 0.5); double vy = 0.5*(ran() - 0.5); double vz = 1.6*(ran() - 0.5);
+	LorentzBoost<double> lboost(vx, vy, vz);
+	
+	//boosting should leave the invariant mass unchanged, and boosting back should return the original vector
+	Vec4<double> boosted = vec.boost(vx, vy, vz);
+	assert( is_close(boosted.t()*boosted.t() - boosted.x()*boosted.x() - boosted.y()*boosted.y() - boosted.z()*boosted.z(),
+	  vec.t()*vec.t() - vec.x()*vec.x() - vec.y()*vec.y() - vec.z()*vec.z(), error*1000.) );
+	Vec4<double> back = boosted.boost(-vx, -vy, -vz);
+	assert( is_close(back.t(), vec.t(), error) ); assert( is_close(back.x(), vec.x(), error) );
+	assert( is_close(back.y(), vec.y(), error) ); assert( is_close(back.z(), vec.z(), error) );
+	
+	//the single and batched LorentzBoost functions should match the Vec4 boost (over more than one block of the array form)
+	const int n_vec = 150; Vec4<double> vecs[n_vec]; double ts[n_vec], xs[n_vec], ys[n_vec], zs[n_vec];
+	for(int i=0; i<n_vec; ++i){
+		vecs[i] = Vec4<double>(10.*ran(), 10.*ran()-5., 10.*ran()-5., 10.*ran()-5.);
+		ts[i] = vecs[i].t(); xs[i] = vecs[i].x(); ys[i] = vecs[i].y(); zs[i] = vecs[i].z();
+	}
+	Vec4<double> single = lboost.apply(vecs[0]);
+	lboost.apply(vecs, n_vec); lboost.apply(ts, xs, ys, zs, n_vec);
+	assert( is_close(single.t(), vecs[0].t(), error) ); assert( is_close(single.z(), vecs[0].z(), error) );
+	for(int i=0; i<n_vec; ++i){
+		assert( is_close(ts[i], vecs[i].t(), error) ); assert( is_close(xs[i], vecs[i].x(), error) );
+		assert( is_close(ys[i], vecs[i].y(), error) ); assert( is_close(zs[i], vecs[i].z(), error) );
+	}
+	
 	//Success!
 	std::cout << "\n\n SUCCESS: Test of Vec4 class passed.\n\n";
 	
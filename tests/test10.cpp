@@ -0,0 +1,66 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: test10.cpp
+*
+* Description: Test of the Optical class
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes
+#include <assert.h>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include "Optical.h"
+#include "Generator.h"
+
+int main(){
+	const double pi = 3.14159265358979;
+	
+	//p+p with the black disk: a collision exactly inside the collision distance, so sigma_inel is the disk area and every event has one
+	Settings pp; pp.nuctypea = 0; pp.num_pro_a = 1; pp.num_neu_a = 0; pp.nuctypeb = 0; pp.num_pro_b = 1; pp.num_neu_b = 0;
+	Optical opt_pp(pp); double d = pp.coll_dist;
+	assert(std::abs(opt_pp.sigma_inel() - pi*d*d) < 1.e-6*pi*d*d);
+	assert(opt_pp.at(0.5*d).p_inel == 1.); assert(opt_pp.at(1.01*d).p_inel == 0.);
+	Optical::Point mb = opt_pp.min_bias(); assert(std::abs(mb.n_coll - 1.) < 1.e-6); assert(std::abs(mb.n_part - 2.) < 1.e-6);
+	
+	//p+Au: P_inel and N_coll fall with b, and N_part is one more than N_coll whenever there is a collision
+	Settings pa; pa.nuctypea = 0; pa.num_pro_a = 1; pa.num_neu_a = 0; pa.nuctypeb = 2; pa.num_pro_b = 79; pa.num_neu_b = 118;
+	pa.n_eve = 5000; pa.seed = 7; pa.coll_kernel = 1; pa.hardcore = 1;
+	Optical opt_pa(pa); std::vector<Optical::Point> grid = opt_pa.grid(0.5);
+	for(int ib=1; ib<grid.size(); ++ib){assert(grid[ib].p_inel <= grid[ib-1].p_inel + 1.e-12); assert(grid[ib].n_coll <= grid[ib-1].n_coll + 1.e-12);}
+	for(int ib=0; ib<grid.size(); ++ib){assert(std::abs(grid[ib].n_part - grid[ib].n_coll - grid[ib].p_inel) < 1.e-6);}
+	
+	//the sum rule of N_coll: its integral over the impact parameter plane is n_a n_b sigma_nn, which checks the thickness folds
+	Settings aa; aa.nuctypea = 2; aa.num_pro_a = 79; aa.num_neu_a = 118; aa.nuctypeb = 2; aa.num_pro_b = 79; aa.num_neu_b = 118;
+	Optical opt_aa(aa); mb = opt_aa.min_bias();
+	assert(std::abs(mb.n_coll*opt_aa.sigma_inel()/(197.*197.*pi*d*d) - 1.) < 0.01);
+	
+	//the Monte Carlo agrees with the optical minimum bias means up to the hard-core correlations the optical model leaves out (a few percent)
+	Generator gen(pa); double n_coll = 0.; double n_part = 0.;
+	while(gen.next()){n_coll += gen.event().n_coll(); n_part += gen.event().n_part();}
+	mb = opt_pa.min_bias(); n_coll /= gen.i_eve(); n_part /= gen.i_eve();
+	assert(std::abs(n_coll/mb.n_coll - 1.) < 0.06); assert(std::abs(n_part/mb.n_part - 1.) < 0.05);
+	
+	std::cout << "\n\n SUCCESS: Test of Optical class passed.\n\n";
+	
+return 0;
+}
@@ -0,0 +1,101 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: test11.cpp
+*
+* Description: Test of the TaskPool class and the split collision pass
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes
+#include <assert.h>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include "TaskPool.h"
+#include "Event.h"
+
+//generates n_eve events with and without the pool from the same seed, checking that every result is the same
+void compare(Event& plain, Event& split, int n_eve){
+	plain.seed(17); split.seed(17); assert(split.splits()); assert(!plain.splits());
+	int n_a = plain.nuc_a().size(); int n_b = plain.nuc_b().size();
+	for(int i_eve=0; i_eve<n_eve; ++i_eve){
+		plain.gen(); split.gen();
+		assert(plain.n_coll() == split.n_coll()); assert(plain.n_part() == split.n_part());
+		assert(plain.b_x() == split.b_x()); assert(plain.b_y() == split.b_y());
+		assert(std::abs(plain.area() - split.area()) <= 1.e-9*plain.area());
+		if(plain.observables() & Event::OBS_NPART){
+			for(int inuc=0; inuc<n_a; ++inuc){assert(plain.hits_a(inuc) == split.hits_a(inuc));}
+			for(int inuc=0; inuc<n_b; ++inuc){assert(plain.hits_b(inuc) == split.hits_b(inuc));}
+		}
+		if(plain.observables() & Event::OBS_MIDPOINTS){
+			for(int k=0; k<plain.n_coll(); ++k){assert(plain.coll_x(k) == split.coll_x(k)); assert(plain.coll_y(k) == split.coll_y(k));}
+		}
+		if(plain.ecc()){assert(std::abs(plain.ecc(2) - split.ecc(2)) < 1.e-12);}
+		if(plain.hotspots() > 0){assert(plain.n_coll_hs() == split.n_coll_hs()); assert(plain.n_part_hs() == split.n_part_hs());}
+	}
+}
+
+int main(){
+	//every task runs exactly once, on a valid worker, for jobs of any size in a row
+	TaskPool pool(4); assert(pool.size() == 4);
+	for(int n_tasks=0; n_tasks<200; n_tasks+=7){
+		std::vector<int> runs(n_tasks, 0); std::vector<int> worker(n_tasks, -1);
+		pool.run(n_tasks, [&](int task, int iw){++runs[task]; worker[task] = iw;});
+		for(int itask=0; itask<n_tasks; ++itask){assert(runs[itask] == 1); assert((worker[itask] >= 0) && (worker[itask] < 4));}
+	}
+	TaskPool alone(1); int n_run = 0; alone.run(10, [&](int, int iw){assert(iw == 0); ++n_run;}); assert(n_run == 10);
+	
+	//Au+Au with the black disk: both pair search strategies and precisions, with eccentricities on
+	for(int strategy=0; strategy<2; ++strategy){
+		for(int single=0; single<2; ++single){
+			Event plain(2, 79, 118, 2, 79, 118, 1.5); Event split(2, 79, 118, 2, 79, 118, 1.5);
+			plain.strategy(strategy); split.strategy(strategy); plain.single(single); split.single(single); plain.ecc(true); split.ecc(true);
+			split.pool(&pool);
+			compare(plain, split, 100);
+		}
+	}
+	
+	//only some observables, so the split pass skips the same things as the unsplit one
+	Event plain_o(2, 79, 118, 2, 79, 118, 1.); Event split_o(2, 79, 118, 2, 79, 118, 1.);
+	plain_o.observables(Event::OBS_AREA); split_o.observables(Event::OBS_AREA); split_o.pool(&pool);
+	compare(plain_o, split_o, 100);
+	
+	//hotspot mode with a heavy nucleus a
+	Event plain_hs(2, 29, 34, 2, 79, 118, 1.); Event split_hs(2, 29, 34, 2, 79, 118, 1.);
+	plain_hs.hotspots(3, 0.6, 0.4); split_hs.hotspots(3, 0.6, 0.4); split_hs.pool(&pool);
+	compare(plain_hs, split_hs, 50);
+	
+	//the gray disk and Gaussian profiles, whose draws are keyed to the nucleon indices of each pair, with both pair search strategies
+	for(int profile=1; profile<=2; ++profile){
+		for(int strategy=0; strategy<2; ++strategy){
+			Event plain_p(2, 79, 118, 2, 79, 118, 1.2); Event split_p(2, 79, 118, 2, 79, 118, 1.2);
+			plain_p.profile(profile, 0.6); split_p.profile(profile, 0.6); plain_p.strategy(strategy); split_p.strategy(strategy); split_p.pool(&pool);
+			compare(plain_p, split_p, 50);
+		}
+	}
+	
+	//nothing is split where the outer loop is a light nucleus
+	Event pa(0, 1, 0, 2, 79, 118, 1.); pa.pool(&pool); assert(!pa.splits());
+	
+	std::cout << "\n\n SUCCESS: Test of TaskPool class and split collision pass passed.\n\n";
+	
+return 0;
+}
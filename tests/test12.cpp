@@ -0,0 +1,85 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: test12.cpp
+*
+* Description: Test of the CrossSection class and the inelastic cross section estimators
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes
+#include <assert.h>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cmath>
+#include "CrossSection.h"
+#include "Event.h"
+#include "Stats.h"
+
+//the estimate of the event loop (the first impact parameter of every event) and of the fast mode (n_b impact parameters per pair of nuclei)
+void estimate(Event& event, int n_eve, int n_pairs, int n_b, CrossSection& run, CrossSection& fast){
+	event.seed(5);
+	for(int i_eve=0; i_eve<n_eve; ++i_eve){event.gen(); run.add(event.trials(), 1, (event.trials() == 1) ? event.b_area() : 0., event.b_area());}
+	for(int ipair=0; ipair<n_pairs; ++ipair){double area = 0.; int hits = event.xsec_trials(n_b, area); fast.add(n_b, hits, area*hits/n_b, area);}
+}
+
+int main(){
+	const double pi = 3.14159265358979;
+	
+	//mean and standard error of known samples, merging, and the binary state
+	CrossSection xs; double samples[4] = {1., 2., 3., 6.};
+	for(int isamp=0; isamp<4; ++isamp){xs.add(2, 1, samples[isamp], 10.);}
+	assert(xs.sigma() == 3.); assert(std::abs(xs.err() - std::sqrt(14./3./4.)) < 1.e-12); assert(xs.mean_area() == 10.);
+	assert(xs.n_samples() == 4); assert(xs.n_trials() == 8); assert(xs.n_hits() == 4);
+	CrossSection other; other.add(1, 1, 3., 20.); xs.merge(other); assert(xs.n_samples() == 5); assert(xs.sigma() == 3.);
+	std::ostringstream state; xs.write_state(state); std::istringstream in(state.str()); CrossSection copy(in); assert(in);
+	assert(copy.sigma() == xs.sigma()); assert(copy.err() == xs.err()); assert(copy.n_trials() == xs.n_trials()); assert(copy.mean_area() == xs.mean_area());
+	
+	//p+p: every profile has sigma_inel = pi*coll_dist^2, and with the black disk every impact parameter of the disk collides
+	Event pp(0, 1, 0, 0, 1, 0, 1.); CrossSection run_pp; CrossSection fast_pp;
+	estimate(pp, 1000, 100, 10, run_pp, fast_pp);
+	assert(std::abs(run_pp.sigma() - pi) < 1.e-9); assert(run_pp.n_trials() == 1000); assert(std::abs(fast_pp.sigma() - pi) < 1.e-9);
+	Event pg(0, 1, 0, 0, 1, 0, 1.); pg.profile(2, 0.6); CrossSection run_pg; CrossSection fast_pg;
+	estimate(pg, 40000, 4000, 50, run_pg, fast_pg);
+	assert(std::abs(run_pg.sigma() - pi) < 4.*run_pg.err()); assert(std::abs(fast_pg.sigma() - pi) < 4.*fast_pg.err());
+	assert(run_pg.n_trials() > 10*run_pg.n_samples()); assert(fast_pg.n_trials() == 50*4000);
+	
+	//p+Au and hotspot p+Au: both estimates agree, and the fast one is the more precise
+	Event pa(0, 1, 0, 2, 79, 118, 1.); CrossSection run_pa; CrossSection fast_pa;
+	estimate(pa, 4000, 1000, 50, run_pa, fast_pa);
+	assert(std::abs(run_pa.sigma() - fast_pa.sigma()) < 4.*std::sqrt(run_pa.err()*run_pa.err() + fast_pa.err()*fast_pa.err()));
+	assert(fast_pa.err() < run_pa.err()); assert(std::abs(fast_pa.sigma()/190. - 1.) < 0.1);
+	Event hs(0, 1, 0, 2, 79, 118, 1.); hs.hotspots(3, 0.6, 0.4); CrossSection run_hs; CrossSection fast_hs;
+	estimate(hs, 4000, 1000, 50, run_hs, fast_hs);
+	assert(std::abs(run_hs.sigma() - fast_hs.sigma()) < 4.*std::sqrt(run_hs.err()*run_hs.err() + fast_hs.err()*fast_hs.err()));
+	
+	//the histogram statistics keep the event loop estimate, through merging and the binary state
+	std::vector<double> bins_n = {0., 10., 100.}; std::vector<double> bins_a = {0., 100.};
+	Stats stats(bins_n, bins_a); Stats more(bins_n, bins_a); pa.seed(9);
+	for(int i_eve=0; i_eve<200; ++i_eve){pa.gen(); ((i_eve%2 == 0) ? stats : more).fill(pa);}
+	stats.merge(more); assert(stats.xsec().n_samples() == 200); assert(stats.xsec().n_hits() == 200); assert(stats.xsec().n_trials() >= 200);
+	std::stringstream stats_state; stats.write_state(stats_state); Stats back = Stats::read_state(stats_state, "stream");
+	assert(back.xsec().sigma() == stats.xsec().sigma()); assert(back.xsec().n_trials() == stats.xsec().n_trials()); assert(back.n_eve() == 200);
+	
+	std::cout << "\n\n SUCCESS: Test of CrossSection class passed.\n\n";
+	
+return 0;
+}
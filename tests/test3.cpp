@@ -45,6 +45,9 @@ int main(){
 	std::array<int,std::mt19937_64::state_size> seedarray; std::generate_n(seedarray.data(), seedarray.size(), std::ref(rd));
 	std::seed_seq seeds(std::begin(seedarray), std::end(seedarray)); eng.seed(seeds);
 	
+	//maximum allowable error
+	double error = 0.00001;
+	
 	//proton, neutron particle ids
 	int id_p = 2212; int id_n = 2112;
 	
@@ -72,6 +75,19 @@ int main(){
 	assert(npCheckB == 1  ); assert(nnCheckB == 1  );
 	assert(npCheckC == npC); assert(nnCheckC == nnC);
 	
+	//the nucleon records are compact, and a full Nucleon made on demand carries the same values
+	assert(sizeof(PackedNucleon) <= 24);
+	for(int i=0; i<npC+nnC; ++i){
+		Nucleon nuc = nucC.nucleon(i);
+		assert(nuc.id() == nucC[i].id()); assert(nuc.stat() == nucC[i].stat());
+		assert( is_close(nuc.x(), nucC[i].x(), error) ); assert( is_close(nuc.y(), nucC[i].y(), error) ); assert( is_close(nuc.z(), nucC[i].z(), error) );
+	}
+	
+	//both hard-core checks accept the same nucleons, so the same seed gives the same heavy nucleus
+	Nucleus nucD(typeC, npC, nnC); nucC.seed(2020); nucD.seed(2020); nucC.hardcore(0); nucD.hardcore(1);
+	nucC.fill(); nucD.fill();
+	for(int i=0; i<npC+nnC; ++i){assert(nucC[i].x() == nucD[i].x()); assert(nucC[i].y() == nucD[i].y()); assert(nucC[i].id() == nucD[i].id());}
+	
 	//Success!
 	std::cout << "\n\n SUCCESS: Test of Nucleus class passed.\n\n";
 	
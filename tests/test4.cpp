@@ -0,0 +1,78 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: test4.cpp
+*
+* Description: A test of the Grid class
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes
+#include <assert.h>
+#include <iostream>
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include "Grid.h"
+
+std::mt19937_64 eng; //RNG - Mersenne Twist - 64 bit
+double ran() {std::uniform_real_distribution<double> uniran(0.,1.); return uniran(eng);}
+
+//returns true if the 2 given values are closer than the error bound given by the last value
+bool is_close(double val1, double val2, double err){return (std::abs(val1 - val2) < err);}
+
+int main(){
+	//seeding the mt19937_64 object (RNG - Mersenne Twist - 64 bit) 'eng'
+	std::random_device rd;
+	std::array<int,std::mt19937_64::state_size> seedarray; std::generate_n(seedarray.data(), seedarray.size(), std::ref(rd));
+	std::seed_seq seeds(std::begin(seedarray), std::end(seedarray)); eng.seed(seeds);
+	
+	//maximum allowable (relative) error of the grid integral
+	double error = 0.001;
+	
+	//a 20 fm wide grid with 0.1 fm cells and 0.5 fm sources
+	Grid grid(200, 0.1, 0.5);
+	
+	//depositing sources well inside the grid, with random weights
+	int n_src = 50; double w_tot = 0.;
+	for(int i=0; i<n_src; ++i){
+		double w = 0.5 + ran(); w_tot += w;
+		grid.deposit(10.*ran() - 5., 10.*ran() - 5., w);
+	}
+	
+	//the grid should integrate to the total weight of the sources
+	double integral = 0.;
+	for(int iy=0; iy<grid.n(); ++iy){for(int ix=0; ix<grid.n(); ++ix){integral += grid(ix, iy)*grid.step()*grid.step();}}
+	assert( is_close(integral/w_tot, 1., error) );
+	
+	//after clearing, a single source at the center should peak in the central cells, and a source far off the grid should leave it empty
+	grid.clear();
+	grid.deposit(50., -50.);
+	for(int iy=0; iy<grid.n(); ++iy){for(int ix=0; ix<grid.n(); ++ix){assert(grid(ix, iy) == 0.);}}
+	grid.deposit(0., 0.);
+	assert( grid(grid.n()/2, grid.n()/2) > grid(grid.n()/2 + 5, grid.n()/2) );
+	assert( is_close(grid(grid.n()/2, grid.n()/2), grid(grid.n()/2 - 1, grid.n()/2 - 1), 1.e-5) );
+	
+	//Success!
+	std::cout << "\n\n SUCCESS: Test of Grid class passed.\n\n";
+	
+return 0;
+}
@@ -0,0 +1,87 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: test5.cpp
+*
+* Description: Test of the Random class
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes
+#include <assert.h>
+#include <iostream>
+#include <cmath>
+#include "Random.h"
+
+//returns true if the 2 given values are closer than the error bound given by the last value
+bool is_close(double val1, double val2, double err){return (std::abs(val1 - val2) < err);}
+
+int main(){
+	//maximum allowable error of the sample means, and of the polynomial cos/sin
+	double error = 0.01; double trig_error = 1.e-13;
+	int n = 100000;
+	
+	//uniform values stay in [0,1) with mean 1/2 and variance 1/12
+	Random rng; double sum = 0.; double sum2 = 0.;
+	for(int i=0; i<n; ++i){double u = rng.uniform(); assert(u >= 0. && u < 1.); sum += u; sum2 += u*u;}
+	assert( is_close(sum/n, 0.5, error) );
+	assert( is_close(sum2/n - (sum/n)*(sum/n), 1./12., error) );
+	
+	//the same seed gives the same stream, a different seed a different one
+	Random rng1; Random rng2; rng1.seed(12345); rng2.seed(12345);
+	for(int i=0; i<10000; ++i){assert(rng1.uniform() == rng2.uniform());}
+	rng2.seed(54321); assert(rng1.uniform() != rng2.uniform());
+	
+	//stream 1 of a seed is the seeded generator after one jump, and differs from stream 0
+	Random rng3; rng1.seed(12345, 1); rng2.seed(12345); rng2.jump(); rng3.seed(12345);
+	for(int i=0; i<10000; ++i){double u = rng1.uniform(); assert(u == rng2.uniform()); assert(u != rng3.uniform());}
+	
+	//cos and sin of 2*pi*u against libm, including the quarter turn boundaries
+	const int n_u = 1001; double u[n_u]; double c[n_u]; double s[n_u];
+	for(int i=0; i<n_u; ++i){u[i] = double(i)/double(n_u - 1) * 0.999999;}
+	u[250] = 0.125; u[500] = 0.375; u[750] = 0.625;
+	Random::sincos2pi(u, c, s, n_u);
+	for(int i=0; i<n_u; ++i){
+		assert( is_close(c[i], std::cos(2.*M_PI*u[i]), trig_error) );
+		assert( is_close(s[i], std::sin(2.*M_PI*u[i]), trig_error) );
+	}
+	
+	//isotropic directions are unit vectors with zero mean and <z^2> = 1/3; azimuths lie on the unit circle with zero mean
+	double mean[3] = {0., 0., 0.}; double z2 = 0.;
+	for(int i=0; i<n; ++i){
+		double x, y, z; rng.direction(x, y, z);
+		assert( is_close(x*x + y*y + z*z, 1., 1.e-12) );
+		mean[0] += x; mean[1] += y; mean[2] += z; z2 += z*z;
+	}
+	for(int i=0; i<3; ++i){assert( is_close(mean[i]/n, 0., error) );}
+	assert( is_close(z2/n, 1./3., error) );
+	double mean_c = 0.; double mean_s = 0.;
+	for(int i=0; i<n; ++i){
+		double cp, sp; rng.azimuth(cp, sp);
+		assert( is_close(cp*cp + sp*sp, 1., 1.e-12) );
+		mean_c += cp; mean_s += sp;
+	}
+	assert( is_close(mean_c/n, 0., error) && is_close(mean_s/n, 0., error) );
+	
+	//Success!
+	std::cout << "\n\n SUCCESS: Test of Random class passed.\n\n";
+	
+return 0;
+}
@@ -0,0 +1,124 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: test6.cpp
+*
+* Description: Test of the Generator library and its C interface
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes
+#include <assert.h>
+#include <iostream>
+#include <vector>
+#include "Generator.h"
+#include "collider_c.h"
+
+//callback for the C push interface, collecting N_coll
+int collect(const collider_event* event, collider_gen*, void* user){
+	std::vector<int>& n_coll = *(std::vector<int>*)user;
+	assert(event->index == n_coll.size());
+	n_coll.push_back(event->n_coll);
+	
+return (n_coll.size() < 150) ? 1 : 0;
+}
+
+int main(){
+	//a seeded d+Au configuration, with the kernel choice fixed so nothing is benchmarked
+	Settings settings; settings.n_eve = 200; settings.seed = 99;
+	settings.nuctypea = 1; settings.num_pro_a = 1; settings.num_neu_a = 1; settings.num_pro_b = 79; settings.num_neu_b = 118;
+	settings.coll_kernel = 1; settings.hardcore = 1;
+	
+	//pull interface: every event is generated once, then the run is over
+	Generator pull(settings); std::vector<int> n_coll; std::vector<int> n_part;
+	while(pull.next()){n_coll.push_back(pull.event().n_coll()); n_part.push_back(pull.event().n_part());}
+	assert(n_coll.size() == 200); assert(pull.done()); assert(!pull.next()); assert(pull.i_eve() == 200);
+	
+	//push interface with the same seed gives the same events, and stops when the callback says so
+	Generator push(settings); int i_eve = 0;
+	int n_run = push.run([&](Event& event){assert(event.n_coll() == n_coll[i_eve]); assert(event.n_part() == n_part[i_eve]); return (++i_eve < 50);});
+	assert(n_run == 50); assert(push.i_eve() == 50);
+	
+	//histograms count every generated event
+	Generator hist(settings); std::vector<double> bins_n = {0., 10., 20., 40., 100.}; std::vector<double> bins_a = {0., 10., 100.};
+	hist.histogram(bins_n, bins_a); while(hist.next()){}
+	assert(hist.has_stats()); assert(hist.stats().n_eve() == 200);
+	
+	//observable selection: with n_coll alone the same events are made, n_part and the area are left at zero and their histograms stay empty
+	//(also with the all pairs kernel and single precision, each its own compiled kernel); with ecc on, the participants are computed anyway
+	for(int ivar=0; ivar<2; ++ivar){
+		Settings obs_settings = settings; obs_settings.observables = 0; obs_settings.coll_kernel = ivar; obs_settings.single_prec = (ivar == 1);
+		Generator obs(obs_settings); obs.histogram(bins_n, bins_a); i_eve = 0;
+		while(obs.next()){
+			assert(obs.event().n_coll() == n_coll[i_eve]); assert(obs.event().n_part() == 0); assert(obs.event().area() == 0.); ++i_eve;
+		}
+		assert(obs.stats().n_coll().val_bin(1) == hist.stats().n_coll().val_bin(1)); assert(obs.stats().n_part().val_bin(1) == 0.);
+	}
+	Settings ecc_settings = settings; ecc_settings.observables = 0; ecc_settings.ecc = true;
+	assert(ecc_settings.needed_observables() == Event::OBS_NPART);
+	Generator ecc(ecc_settings); i_eve = 0;
+	while(ecc.next()){assert(ecc.event().n_part() == n_part[i_eve]); assert(ecc.event().area() == 0.); ++i_eve;}
+	
+	//hotspot mode: the per-hotspot counts add up to the hotspot N_coll on both sides, every colliding nucleon pair has at least one colliding
+	//hotspot pair, and the hotspot level histograms are kept
+	Settings hs_settings = settings; hs_settings.hotspots = 3; hs_settings.ecc = true;
+	Generator hs(hs_settings); hs.histogram(bins_n, bins_a);
+	while(hs.next()){
+		Event& event = hs.event(); int sum_a = 0; int sum_b = 0; int n_part_hs = 0;
+		for(int ihs=0; ihs<3*2; ++ihs){sum_a += event.hs_hits_a(ihs); n_part_hs += (event.hs_hits_a(ihs) > 0);}
+		for(int ihs=0; ihs<3*197; ++ihs){sum_b += event.hs_hits_b(ihs); n_part_hs += (event.hs_hits_b(ihs) > 0);}
+		assert(sum_a == event.n_coll_hs()); assert(sum_b == event.n_coll_hs()); assert(n_part_hs == event.n_part_hs());
+		assert(event.n_coll() >= 1); assert(event.n_coll_hs() >= event.n_coll()); assert(event.n_part_hs() >= event.n_part());
+	}
+	assert(hs.stats().has_hs()); assert(!hist.stats().has_hs());
+	
+	//C interface: the same configuration, given through the struct and the extra tag/value pairs
+	collider_config config; collider_config_default(&config);
+	config.n_eve = 200; config.seed = 99; config.nuc_a = 1; config.npro_a = 1; config.nneu_a = 1; config.npro_b = 79; config.nneu_b = 118;
+	config.extra = "collkernel sorted hardcore cells";
+	collider_gen* gen = collider_new(&config); assert(gen != NULL);
+	collider_event event; int n_eve = 0;
+	while(collider_next(gen, &event)){
+		assert(event.index == n_eve); assert(event.n_coll == n_coll[n_eve]); assert(event.n_part == n_part[n_eve]);
+		
+		//nucleon positions and collision counts: the binary collisions of each side add up to N_coll
+		int n_a = collider_n_nucleons(gen, 0); int n_b = collider_n_nucleons(gen, 1); assert(n_a == 2); assert(n_b == 197);
+		std::vector<double> x(n_b); std::vector<int> hits(n_b); int sum_a = 0; int sum_b = 0;
+		collider_nucleons(gen, 0, &x[0], NULL, NULL, &hits[0]); for(int i=0; i<n_a; ++i){sum_a += hits[i];}
+		collider_nucleons(gen, 1, &x[0], NULL, NULL, &hits[0]); for(int i=0; i<n_b; ++i){sum_b += hits[i];}
+		assert(sum_a == event.n_coll); assert(sum_b == event.n_coll);
+		++n_eve;
+	}
+	assert(n_eve == 200);
+	collider_free(gen);
+	
+	//C push interface, stopped early by the callback
+	gen = collider_new(&config); std::vector<int> n_coll_c;
+	assert(collider_run(gen, collect, &n_coll_c) == 150);
+	for(int i=0; i<150; ++i){assert(n_coll_c[i] == n_coll[i]);}
+	collider_free(gen);
+	
+	//an unknown tag is refused
+	config.extra = "nosuchtag 1"; assert(collider_new(&config) == NULL);
+	
+	std::cout << "\n\n SUCCESS: Test of Generator library passed.\n\n";
+	
+return 0;
+}
@@ -0,0 +1,75 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: test7.cpp
+*
+* Description: Test of the StatusFile class
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes
+#include <assert.h>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <vector>
+#include "Event.h"
+#include "Stats.h"
+#include "StatusFile.h"
+
+int main(){
+	std::string filename = "test7_status.dat";
+	std::vector<double> bins_n = {0., 5., 10., 50., 100., 500.}; std::vector<double> bins_a = {0., 10., 100., 1000.};
+	Stats stats(bins_n, bins_a);
+	Event event(2, 79, 118, 2, 79, 118); event.seed(3);
+	
+	//the first snapshot is empty, each update shows the histograms and counters at that point
+	StatusFile status(filename, stats, 40);
+	StatusFile::Snapshot snap;
+	assert(StatusFile::read(filename, snap)); assert(snap.n_done == 0); assert(snap.n_total == 40); assert(!snap.finished);
+	for(int i_eve=0; i_eve<40; ++i_eve){
+		event.gen(); stats.fill(event);
+		if((i_eve+1)%10 == 0){
+			status.update(stats, i_eve+1, 40, 2.*(i_eve+1), i_eve+1 == 40);
+			assert(StatusFile::read(filename, snap));
+			assert(snap.n_done == i_eve+1); assert(snap.rate == 0.5); assert(snap.finished == (i_eve+1 == 40));
+			
+			//the snapshot state is the same as the histograms' own binary state
+			std::ostringstream state; stats.write_state(state); assert(snap.state == state.str());
+			std::istringstream in(snap.state); Stats copy = Stats::read_state(in, filename);
+			assert(copy.n_eve() == i_eve+1); assert(copy.same_bins(stats));
+			for(int ibin=0; ibin<stats.n_coll().n_bins(); ++ibin){assert(copy.n_coll().val_bin(ibin) == stats.n_coll().val_bin(ibin));}
+		}
+	}
+	
+	//a writer that died during an update leaves the sequence number (right after the tag) odd, a reader then gives up instead of waiting
+	{std::fstream file(filename.c_str(), std::ios::in | std::ios::out | std::ios::binary); unsigned long long odd = 9;
+	file.seekp(8); file.write((const char*)&odd, sizeof(odd));}
+	assert(!StatusFile::read(filename, snap));
+	
+	//anything else is not taken as a status file
+	assert(!StatusFile::read("test7_missing.dat", snap));
+	std::remove(filename.c_str());
+	
+	std::cout << "\n\n SUCCESS: Test of StatusFile class passed.\n\n";
+	
+return 0;
+}
@@ -0,0 +1,96 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: test8.cpp
+*
+* Description: Test of the NucleonWriter and NucleonReader classes
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes
+#include <assert.h>
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "Event.h"
+#include "NucleonFile.h"
+
+int main(){
+	std::string filename = "test8_nucleons.dat"; const double res = 0.01; const int n_eve = 50;
+	Event event(2, 29, 34, 2, 79, 118); event.seed(5);
+	
+	for(int delta=0; delta<2; ++delta){
+		//the nucleons of every event, as they were when written
+		std::vector<std::vector<double> > xs, ys, zs; std::vector<std::vector<int> > ids, stats; std::vector<int> n_colls, n_parts; std::vector<double> bxs;
+		{
+			NucleonWriter writer(filename, res, delta, event.nuc_a().size(), event.nuc_b().size());
+			for(int i_eve=0; i_eve<n_eve; ++i_eve){
+				event.gen(); writer.write(event);
+				for(int inuc=0; inuc<2; ++inuc){
+					Nucleus& nuc = (inuc == 0) ? event.nuc_a() : event.nuc_b();
+					xs.emplace_back(); ys.emplace_back(); zs.emplace_back(); ids.emplace_back(); stats.emplace_back();
+					for(int i=0; i<nuc.size(); ++i){
+						xs.back().push_back(nuc[i].x()); ys.back().push_back(nuc[i].y()); zs.back().push_back(nuc[i].z());
+						ids.back().push_back(nuc[i].id()); stats.back().push_back(nuc[i].stat());
+					}
+				}
+				n_colls.push_back(event.n_coll()); n_parts.push_back(event.n_part()); bxs.push_back(event.b_x());
+			}
+			assert(writer.n_events() == n_eve);
+		}
+		
+		//events are read back out of order, every nucleon is within half the resolution of the original with the same isospin and status
+		//with delta encoding the nucleons of each nucleus come back in order of x, so each one is matched to an original nucleon
+		NucleonReader reader(filename);
+		assert(reader.n_events() == n_eve); assert(reader.resolution() == res); assert(reader.delta() == (delta == 1));
+		assert(reader.n_a() == 63); assert(reader.n_b() == 197);
+		NucleonReader::Record rec;
+		for(int k=0; k<n_eve; ++k){
+			int i_eve = (7*k + 3)%n_eve; reader.event(i_eve, rec);
+			assert(rec.n_coll == n_colls[i_eve]); assert(rec.n_part == n_parts[i_eve]); assert(rec.b_x == bxs[i_eve]);
+			int n_part = 0;
+			for(int inuc=0; inuc<2; ++inuc){
+				const std::vector<NucleonReader::Nucleon>& nuc = (inuc == 0) ? rec.a : rec.b; int iorig = 2*i_eve + inuc;
+				assert(nuc.size() == xs[iorig].size()); std::vector<bool> used(nuc.size(), false);
+				for(int i=0; i<nuc.size(); ++i){
+					if(delta && (i > 0)){assert(nuc[i].x >= nuc[i-1].x);}
+					int j = i;
+					if(delta){
+						for(j=0; j<nuc.size(); ++j){
+							if(!used[j] && (std::fabs(nuc[i].x - xs[iorig][j]) <= 0.5001*res) && (std::fabs(nuc[i].y - ys[iorig][j]) <= 0.5001*res) &&
+							  (std::fabs(nuc[i].z - zs[iorig][j]) <= 0.5001*res)){break;}
+						}
+						assert(j < nuc.size()); used[j] = true;
+					}
+					assert(std::fabs(nuc[i].x - xs[iorig][j]) <= 0.5001*res); assert(std::fabs(nuc[i].y - ys[iorig][j]) <= 0.5001*res);
+					assert(std::fabs(nuc[i].z - zs[iorig][j]) <= 0.5001*res);
+					assert(nuc[i].id == ids[iorig][j]); assert(nuc[i].stat == stats[iorig][j]); n_part += nuc[i].stat;
+				}
+			}
+			assert(n_part == rec.n_part);
+		}
+	}
+	std::remove(filename.c_str());
+	
+	std::cout << "\n\n SUCCESS: Test of NucleonWriter and NucleonReader classes passed.\n\n";
+	
+return 0;
+}
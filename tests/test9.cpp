@@ -0,0 +1,83 @@
+
+/***************************************************************************************************************************************************
+*
+* Filename: test9.cpp
+*
+* Description: Test of the QuantileSketch class
+*
+* Copyright (c) 2020, Michael Kordell II
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+* 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+* 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+*    software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+* CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+***************************************************************************************************************************************************/
+
+//includes
+#include <assert.h>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "QuantileSketch.h"
+#include "Random.h"
+
+int main(){
+	//values from a known distribution (u^2, with N_coll = 2*value and N_part = value), added to one sketch and split over four to be merged
+	const int n_val = 400000; const int k = 400;
+	Random rng; rng.seed(11);
+	QuantileSketch all(k); std::vector<QuantileSketch> parts(4, QuantileSketch(k)); std::vector<double> vals(n_val);
+	for(int i=0; i<n_val; ++i){
+		double u = rng.uniform(); vals[i] = u*u;
+		all.add(vals[i], 2.*vals[i], vals[i]); parts[i%4].add(vals[i], 2.*vals[i], vals[i]);
+	}
+	QuantileSketch merged(k); for(int ipart=0; ipart<4; ++ipart){merged.merge(parts[ipart]);}
+	assert(all.n() == n_val); assert(merged.n() == n_val);
+	
+	//every quantile is within the rank error of the exact one
+	std::sort(vals.begin(), vals.end());
+	for(int iq=1; iq<20; ++iq){
+		double q = iq/20.;
+		for(int isk=0; isk<2; ++isk){
+			double val = (isk == 0) ? all.quantile(q) : merged.quantile(q);
+			double rank = double(std::lower_bound(vals.begin(), vals.end(), val) - vals.begin())/n_val;
+			assert(std::abs(rank - q) < 0.01);
+		}
+	}
+	
+	//the state has the same size however full the sketch is, and reads back to the same quantiles
+	std::ostringstream empty_state; QuantileSketch(k).write_state(empty_state);
+	std::ostringstream state; merged.write_state(state); assert(state.str().size() == empty_state.str().size());
+	std::istringstream in(state.str()); QuantileSketch copy(in); assert(in);
+	assert(copy.n() == n_val); assert(copy.quantile(0.3) == merged.quantile(0.3));
+	
+	//centrality classes: ten classes from the largest values down, class i has u in [1-(i+1)/10, 1-i/10] and the mean of u^2 over it
+	std::vector<QuantileSketch::Class> classes = merged.classes(10);
+	assert(classes.size() == 10); assert(classes[0].pct_lo == 0.); assert(classes[9].pct_hi == 100.);
+	for(int icl=0; icl<10; ++icl){
+		double u_lo = 1. - (icl + 1)/10.; double u_hi = 1. - icl/10.;
+		double mean = (std::pow(u_hi, 3) - std::pow(u_lo, 3))/(3.*(u_hi - u_lo));
+		assert(std::abs(classes[icl].n_part - mean) < 0.01); assert(std::abs(classes[icl].n_coll - 2.*classes[icl].n_part) < 1.e-9);
+		assert(classes[icl].key_lo <= classes[icl].key_hi); if(icl > 0){assert(classes[icl].key_hi <= classes[icl-1].key_lo);}
+	}
+	
+	//with fewer values than the sketch holds, everything is kept and the quantiles are exact
+	QuantileSketch small(k); for(int i=0; i<100; ++i){small.add(i, 0., 0.);}
+	assert(small.quantile(0.5) == 50.); assert(small.classes(4)[0].key_hi == 99.); assert(small.classes(4)[0].key_lo == 75.);
+	
+	std::cout << "\n\n SUCCESS: Test of QuantileSketch class passed.\n\n";
+	
+return 0;
+}